@@ -0,0 +1,784 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// benchmark/benchmark_executor.cpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#include "duckdb/duckdb_stable.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace duckdb_stable;
+
+namespace {
+
+//! Runs the executor without a function info: errors turn the row into NULL, like a TRY cast.
+class BenchmarkExecutor : public Executor {
+protected:
+	bool SetError(const char *error_message, idx_t r, Vector &result) override {
+		duckdb_vector_ensure_validity_writable(result.c_vector());
+		duckdb_validity_set_row_invalid(duckdb_vector_get_validity(result.c_vector()), r);
+		return true;
+	}
+};
+
+struct BenchmarkParameters {
+	//! The fraction of input rows that is NULL.
+	double null_ratio;
+	//! The length of generated strings, only used by string inputs.
+	idx_t string_length;
+	//! Whether every row of the input holds the same value.
+	bool constant;
+};
+
+//! Generates the input of a benchmark - the same seed always produces the same data.
+class InputGenerator {
+public:
+	InputGenerator(const BenchmarkParameters &parameters_p, uint64_t seed)
+	    : parameters(parameters_p), random(seed), first(true) {
+	}
+
+public:
+	bool NextIsNull() {
+		return std::uniform_real_distribution<double>(0, 1)(random) < parameters.null_ratio;
+	}
+
+	uint64_t NextInteger() {
+		if (parameters.constant && !first) {
+			return constant_integer;
+		}
+		first = false;
+		constant_integer = random() % 1000000;
+		return constant_integer;
+	}
+
+	//! A zero-padded number that always fits in a UBIGINT. Strings longer than 12 characters are not inlined.
+	const std::string &NextString() {
+		if (parameters.constant && !first) {
+			return constant_string;
+		}
+		first = false;
+		constant_string.assign(parameters.string_length, '0');
+		auto digits = std::min<idx_t>(parameters.string_length, 18);
+		for (idx_t i = parameters.string_length - digits; i < parameters.string_length; i++) {
+			constant_string[i] = static_cast<char>('0' + random() % 10);
+		}
+		return constant_string;
+	}
+
+private:
+	const BenchmarkParameters &parameters;
+	std::mt19937_64 random;
+	bool first;
+	uint64_t constant_integer = 0;
+	std::string constant_string;
+};
+
+template <class TYPE>
+void FillNull(Vector &vector, idx_t r) {
+	typename TYPE::STRUCT_STATE state;
+	TYPE::SetNull(vector, state, r);
+}
+
+void FillUBigint(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<PrimitiveType<uint64_t>>(vector, r);
+			continue;
+		}
+		PrimitiveType<uint64_t>::AssignResult(vector, r, generator.NextInteger());
+	}
+}
+
+void FillHugeint(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<PrimitiveType<hugeint_t>>(vector, r);
+			continue;
+		}
+		auto value = static_cast<int64_t>(generator.NextInteger());
+		PrimitiveType<hugeint_t>::AssignResult(vector, r, hugeint_t(value, static_cast<uint64_t>(value)));
+	}
+}
+
+void FillVarchar(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<PrimitiveType<string_t>>(vector, r);
+			continue;
+		}
+		auto &str = generator.NextString();
+		PrimitiveType<string_t>::AssignResult(vector, r, string_t(str.c_str(), static_cast<uint32_t>(str.size())));
+	}
+}
+
+void FillStruct(Vector &vector, idx_t count, InputGenerator &generator) {
+	using STRUCT_TYPE = StructTypeTernary<PrimitiveType<uint64_t>, PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>;
+	for (idx_t c = 0; c < 3; c++) {
+		auto child = vector.GetChild(c);
+		FillUBigint(child, count, generator);
+	}
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<STRUCT_TYPE>(vector, r);
+		}
+	}
+}
+
+//! The values of the categorical benchmark inputs, every third one is "warm".
+const std::vector<std::string> &Categories() {
+	static std::vector<std::string> categories;
+	if (categories.empty()) {
+		for (idx_t i = 0; i < 16; i++) {
+			categories.push_back("category_" + std::to_string(i) + (i % 3 == 0 ? "_warm" : "_cold"));
+		}
+	}
+	return categories;
+}
+
+void FillEnum(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<EnumType<uint8_t>>(vector, r);
+			continue;
+		}
+		auto code = static_cast<uint8_t>(generator.NextInteger() % Categories().size());
+		EnumType<uint8_t>::AssignResult(vector, r, EnumValue<uint8_t>(code));
+	}
+}
+
+void FillCategoryVarchar(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<PrimitiveType<string_t>>(vector, r);
+			continue;
+		}
+		auto &str = Categories()[generator.NextInteger() % Categories().size()];
+		PrimitiveType<string_t>::AssignResult(vector, r, string_t(str.c_str(), static_cast<uint32_t>(str.size())));
+	}
+}
+
+//! DECIMAL(9,2) values of up to 10000.00.
+void FillDecimal(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<DecimalType<9, 2>>(vector, r);
+			continue;
+		}
+		DecimalType<9, 2>::AssignResult(vector, r, static_cast<int32_t>(generator.NextInteger()));
+	}
+}
+
+//! A 2D point stored as two doubles in a BLOB, against the same points as "x,y" text.
+struct PointView : public BlobView {
+	using BlobView::BlobView;
+
+	double X() const {
+		return Load<double>(0);
+	}
+	double Y() const {
+		return Load<double>(sizeof(double));
+	}
+};
+
+struct PointTraits {
+	using STORAGE_TYPE = string_t;
+	using VIEW = PointView;
+
+	static const char *Name() {
+		return "POINT";
+	}
+
+	static void ParseText(const string_t &text, double &x, double &y) {
+		std::string str(text.GetData(), text.GetSize());
+		char *end;
+		x = strtod(str.c_str(), &end);
+		if (*end != ',') {
+			throw Exception("Invalid POINT \"" + str + "\"");
+		}
+		y = strtod(end + 1, &end);
+	}
+
+	static VIEW Parse(const string_t &text, std::string &buffer) {
+		double x, y;
+		ParseText(text, x, y);
+		BlobView::Append(buffer, x);
+		BlobView::Append(buffer, y);
+		return VIEW(string_t(buffer.data(), static_cast<uint32_t>(buffer.size())));
+	}
+
+	static void Format(const VIEW &value, std::string &buffer) {
+		buffer += std::to_string(value.X()) + "," + std::to_string(value.Y());
+	}
+};
+
+void FillPointVarchar(Vector &vector, idx_t count, InputGenerator &generator) {
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<PrimitiveType<string_t>>(vector, r);
+			continue;
+		}
+		auto text = std::to_string(generator.NextInteger()) + "," + std::to_string(generator.NextInteger());
+		PrimitiveType<string_t>::AssignResult(vector, r, string_t(text.c_str(), static_cast<uint32_t>(text.size())));
+	}
+}
+
+void FillPoint(Vector &vector, idx_t count, InputGenerator &generator) {
+	std::string buffer;
+	for (idx_t r = 0; r < count; r++) {
+		if (generator.NextIsNull()) {
+			FillNull<CustomType<PointTraits>>(vector, r);
+			continue;
+		}
+		auto text = std::to_string(generator.NextInteger()) + "," + std::to_string(generator.NextInteger());
+		buffer.clear();
+		auto point = PointTraits::Parse(string_t(text.c_str(), static_cast<uint32_t>(text.size())), buffer);
+		CustomType<PointTraits>::AssignResult(vector, r, point);
+	}
+}
+
+//! A deterministic function that is expensive per row, like parsing a user agent or looking up a geo IP range.
+struct StretchedHashOperator {
+	static uint64_t Operation(const string_t &input) {
+		auto result = HashUtil::Hash(input);
+		for (idx_t i = 0; i < 256; i++) {
+			result = HashUtil::CombineHash(result, HashUtil::Hash(input) + i);
+		}
+		return result;
+	}
+};
+
+void FillVarcharConstant(Vector &vector, idx_t count, const char *value) {
+	for (idx_t r = 0; r < count; r++) {
+		PrimitiveType<string_t>::AssignResult(vector, r, string_t(value));
+	}
+}
+
+//! A benchmark executes one kernel over a chunk of generated input, the input is built once and reused.
+struct Benchmark {
+	const char *name;
+	bool uses_strings;
+	std::vector<LogicalType> (*input_types)();
+	LogicalType (*result_type)();
+	void (*fill)(DataChunk &input, idx_t count, InputGenerator &generator);
+	void (*execute)(BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count);
+};
+
+std::vector<LogicalType> Types(LogicalType a) {
+	std::vector<LogicalType> result;
+	result.push_back(std::move(a));
+	return result;
+}
+
+std::vector<LogicalType> Types(LogicalType a, LogicalType b) {
+	auto result = Types(std::move(a));
+	result.push_back(std::move(b));
+	return result;
+}
+
+#ifdef DUCKDB_STABLE_MOCK_C_API
+struct DoubleOperator {
+	static uint64_t Operation(uint64_t input) {
+		return input * 2 + 1;
+	}
+};
+#endif
+
+LogicalType StructType() {
+	LogicalType child_types[] = {LogicalType::UBIGINT(), LogicalType::UBIGINT(), LogicalType::UBIGINT()};
+	const char *child_names[] = {"a", "b", "c"};
+	return LogicalType::STRUCT(child_types, child_names, 3);
+}
+
+const Benchmark BENCHMARKS[] = {
+    {"unary_ubigint", false, [] { return Types(LogicalType::UBIGINT()); }, [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillUBigint(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [](uint64_t input) { return input * 2 + 1; });
+     }},
+    {"binary_hugeint_add", false, [] { return Types(LogicalType::HUGEINT(), LogicalType::HUGEINT()); },
+     [] { return LogicalType::HUGEINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     FillHugeint(a, count, generator);
+	     FillHugeint(b, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     executor.ExecuteBinary<PrimitiveType<hugeint_t>, PrimitiveType<hugeint_t>, PrimitiveType<hugeint_t>>(
+	         a, b, result, count, [](hugeint_t a_val, hugeint_t b_val) { return a_val + b_val; });
+     }},
+    // The fixed-point kernel against the round trip through DOUBLE that extensions fall back to without it.
+    {"binary_decimal_multiply", false, [] { return Types(LogicalType::DECIMAL(9, 2), LogicalType::DECIMAL(9, 2)); },
+     [] { return LogicalType::DECIMAL(18, 2); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     FillDecimal(a, count, generator);
+	     FillDecimal(b, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     using INPUT = DecimalType<9, 2>;
+	     using RESULT = DecimalType<18, 2>;
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     executor.ExecuteBinary<INPUT, INPUT, RESULT>(a, b, result, count,
+	                                                  DecimalMultiplyOperator<INPUT, INPUT, RESULT>::Operation);
+     }},
+    {"binary_decimal_multiply_double", false,
+     [] { return Types(LogicalType::DECIMAL(9, 2), LogicalType::DECIMAL(9, 2)); },
+     [] { return LogicalType::DECIMAL(18, 2); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     FillDecimal(a, count, generator);
+	     FillDecimal(b, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     executor.ExecuteBinary<PrimitiveType<int32_t>, PrimitiveType<int32_t>, PrimitiveType<int64_t>>(
+	         a, b, result, count, [](int32_t a_val, int32_t b_val) {
+		         auto product = (static_cast<double>(a_val) / 100) * (static_cast<double>(b_val) / 100);
+		         return static_cast<int64_t>(std::llround(product * 100));
+	         });
+     }},
+    {"unary_varchar_length", true, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const string_t &input) { return static_cast<uint64_t>(input.GetSize()); });
+     }},
+    {"unary_varchar_copy", true, [] { return Types(LogicalType::VARCHAR()); }, [] { return LogicalType::VARCHAR(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
+	         a, result, count, [](const string_t &input) { return input; });
+     }},
+    // The string kernels against the byte-at-a-time loops that extensions write without them.
+    {"unary_varchar_ascii_lower", true, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::VARCHAR(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     std::string buffer;
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
+	         a, result, count, [&](const string_t &input) { return AsciiLowerOperator::Operation(input, buffer); });
+     }},
+    {"unary_varchar_ascii_lower_scalar", true, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::VARCHAR(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     std::string buffer;
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
+	         a, result, count, [&](const string_t &input) {
+		         buffer.assign(input.GetData(), input.GetSize());
+		         for (auto &c : buffer) {
+			         c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		         }
+		         return string_t(buffer.data(), input.GetSize());
+	         });
+     }},
+    {"unary_varchar_valid_utf8", true, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::BOOLEAN(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<bool>>(
+	         a, result, count, [](const string_t &input) { return StringKernels::IsValidUTF8(input); });
+     }},
+    {"binary_varchar_contains", true, [] { return Types(LogicalType::VARCHAR(), LogicalType::VARCHAR()); },
+     [] { return LogicalType::BOOLEAN(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     FillVarchar(a, count, generator);
+	     FillVarcharConstant(b, count, "777");
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     executor.ExecuteBinary<PrimitiveType<string_t>, PrimitiveType<string_t>, PrimitiveType<bool>>(
+	         a, b, result, count,
+	         [](const string_t &haystack, const string_t &needle) { return StringKernels::Contains(haystack, needle); });
+     }},
+    {"binary_varchar_contains_scalar", true, [] { return Types(LogicalType::VARCHAR(), LogicalType::VARCHAR()); },
+     [] { return LogicalType::BOOLEAN(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     FillVarchar(a, count, generator);
+	     FillVarcharConstant(b, count, "777");
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     auto b = input.GetVector(1);
+	     executor.ExecuteBinary<PrimitiveType<string_t>, PrimitiveType<string_t>, PrimitiveType<bool>>(
+	         a, b, result, count, [](const string_t &haystack, const string_t &needle) {
+		         auto h = haystack.GetData();
+		         auto n = needle.GetData();
+		         for (idx_t i = 0; i + needle.GetSize() <= haystack.GetSize(); i++) {
+			         idx_t k = 0;
+			         while (k < needle.GetSize() && h[i + k] == n[k]) {
+				         k++;
+			         }
+			         if (k == needle.GetSize()) {
+				         return true;
+			         }
+		         }
+		         return false;
+	         });
+     }},
+    // upper(lower(input)) as one fused row kernel against two functions with a VARCHAR vector in between.
+    {"unary_varchar_fused", true, [] { return Types(LogicalType::VARCHAR()); }, [] { return LogicalType::VARCHAR(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     using FUSED = Fused<AsciiLowerOperator, AsciiUpperOperator>;
+	     auto a = input.GetVector(0);
+	     FUSED::STATIC_DATA data;
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
+	         a, result, count, [&](const string_t &input) { return FUSED::Operation(input, data); });
+     }},
+    {"unary_varchar_chained", true, [] { return Types(LogicalType::VARCHAR()); }, [] { return LogicalType::VARCHAR(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     auto varchar = LogicalType::VARCHAR();
+	     Vector intermediate(duckdb_create_vector(varchar.c_logical_type(), count), true);
+	     std::string buffer;
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
+	         a, intermediate, count,
+	         [&](const string_t &input) { return AsciiLowerOperator::Operation(input, buffer); });
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<string_t>>(
+	         intermediate, result, count,
+	         [&](const string_t &input) { return AsciiUpperOperator::Operation(input, buffer); });
+     }},
+    // Hashing a whole vector at once against hashing it row by row through the executor.
+    {"hash_ubigint", false, [] { return Types(LogicalType::UBIGINT()); }, [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillUBigint(vector, count, generator);
+     },
+     [](BenchmarkExecutor &, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     VectorHash::Hash<uint64_t>(a, count, reinterpret_cast<uint64_t *>(duckdb_vector_get_data(result.c_vector())));
+     }},
+    {"hash_ubigint_rowwise", false, [] { return Types(LogicalType::UBIGINT()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillUBigint(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [](uint64_t input) { return HashUtil::Hash(input); });
+     }},
+    {"hash_varchar", true, [] { return Types(LogicalType::VARCHAR()); }, [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     VectorHash::Hash<string_t>(a, count, reinterpret_cast<uint64_t *>(duckdb_vector_get_data(result.c_vector())));
+     }},
+    {"hash_varchar_rowwise", true, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const string_t &input) { return HashUtil::Hash(input); });
+     }},
+    // A categorical predicate over ENUM codes (evaluated once per dictionary entry) against the same values as VARCHAR.
+    {"unary_enum_category", false, [] { return Types(LogicalType::ENUM(Categories())); },
+     [] { return LogicalType::BOOLEAN(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillEnum(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     std::vector<bool> is_warm;
+	     for (auto &category : Categories()) {
+		     is_warm.push_back(StringKernels::Contains(string_t(category.c_str()), string_t("warm")));
+	     }
+	     executor.ExecuteUnary<EnumType<uint8_t>, PrimitiveType<bool>>(
+	         a, result, count, [&](const EnumValue<uint8_t> &input) { return static_cast<bool>(is_warm[input.code]); });
+     }},
+    {"unary_varchar_category", false, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::BOOLEAN(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillCategoryVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<bool>>(
+	         a, result, count, [](const string_t &input) { return StringKernels::Contains(input, string_t("warm")); });
+     }},
+    // A function over a custom type parsed once at ingest, against re-parsing the same values from VARCHAR per call.
+    {"unary_custom_type_point", false, [] { return Types(CustomType<PointTraits>::CreateLogicalType()); },
+     [] { return LogicalType::DOUBLE(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillPoint(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<CustomType<PointTraits>, PrimitiveType<double>>(
+	         a, result, count, [](const PointView &input) { return input.X() * input.X() + input.Y() * input.Y(); });
+     }},
+    {"unary_varchar_point", false, [] { return Types(LogicalType::VARCHAR()); }, [] { return LogicalType::DOUBLE(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillPointVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<double>>(
+	         a, result, count, [](const string_t &input) {
+		         double x, y;
+		         PointTraits::ParseText(input, x, y);
+		         return x * x + y * y;
+	         });
+     }},
+    // An expensive function over a low-cardinality column with the per-thread memoization cache, and without it.
+    {"unary_varchar_memoized", false, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillCategoryVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     using MEMOIZED = Memoized<StretchedHashOperator, 4096, string_t>;
+	     auto a = input.GetVector(0);
+	     MEMOIZED::STATIC_DATA data;
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [&](const string_t &input) { return MEMOIZED::Operation(input, data); });
+     }},
+    {"unary_varchar_unmemoized", false, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillCategoryVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const string_t &input) { return StretchedHashOperator::Operation(input); });
+     }},
+    {"cast_varchar_ubigint", true, [] { return Types(LogicalType::VARCHAR()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillVarchar(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<PrimitiveType<string_t>, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const string_t &input) {
+		         uint64_t value = 0;
+		         auto data = input.GetData();
+		         for (idx_t i = 0; i < input.GetSize(); i++) {
+			         auto digit = static_cast<uint64_t>(data[i] - '0');
+			         if (digit > 9 || value > (UINT64_MAX - digit) / 10) {
+				         throw Exception("could not cast string to UBIGINT");
+			         }
+			         value = value * 10 + digit;
+		         }
+		         return value;
+	         });
+     }},
+    {"struct_ternary_sum", false, [] { return Types(StructType()); }, [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillStruct(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     using STRUCT_TYPE =
+	         StructTypeTernary<PrimitiveType<uint64_t>, PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>;
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<STRUCT_TYPE, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const STRUCT_TYPE &input) { return input.a_val + input.b_val + input.c_val; });
+     }},
+    // Reading one field of a struct with every field constructed per row against only the field that is read.
+    {"struct_ternary_one_field", false, [] { return Types(StructType()); }, [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillStruct(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     using STRUCT_TYPE =
+	         StructTypeTernary<PrimitiveType<uint64_t>, PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>;
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<STRUCT_TYPE, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const STRUCT_TYPE &input) { return input.b_val; });
+     }},
+    {"struct_lazy_one_field", false, [] { return Types(StructType()); }, [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillStruct(vector, count, generator);
+     },
+     [](BenchmarkExecutor &executor, DataChunk &input, Vector &result, idx_t count) {
+	     using STRUCT_TYPE = LazyStructType<PrimitiveType<uint64_t>, PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>;
+	     auto a = input.GetVector(0);
+	     executor.ExecuteUnary<STRUCT_TYPE, PrimitiveType<uint64_t>>(
+	         a, result, count, [](const STRUCT_TYPE::ARG_TYPE &input) { return input.Get<1>(); });
+     }},
+#ifdef DUCKDB_STABLE_MOCK_C_API
+    // The full scalar function callback (FunctionExecutor and profiling hooks), the mock lets us create the info.
+    {"scalar_function_unary", false, [] { return Types(LogicalType::UBIGINT()); },
+     [] { return LogicalType::UBIGINT(); },
+     [](DataChunk &input, idx_t count, InputGenerator &generator) {
+	     auto vector = input.GetVector(0);
+	     FillUBigint(vector, count, generator);
+     },
+     [](BenchmarkExecutor &, DataChunk &input, Vector &result, idx_t) {
+	     _duckdb_function_info info;
+	     UnaryFunction<DoubleOperator, PrimitiveType<uint64_t>, PrimitiveType<uint64_t>>::ExecuteUnary(
+	         &info, input.c_data_chunk(), result.c_vector());
+     }},
+#endif
+};
+
+DataChunk CreateChunk(std::vector<LogicalType> types) {
+	std::vector<duckdb_logical_type> c_types;
+	for (auto &type : types) {
+		c_types.push_back(type.c_logical_type());
+	}
+	return DataChunk(duckdb_create_data_chunk(c_types.data(), c_types.size()), true);
+}
+
+//! Returns the seconds it takes to execute the benchmark over (at least) the requested number of rows.
+double RunBenchmark(const Benchmark &benchmark, const BenchmarkParameters &parameters, idx_t rows) {
+	auto count = duckdb_vector_size();
+	auto input = CreateChunk(benchmark.input_types());
+	InputGenerator generator(parameters, 42);
+	benchmark.fill(input, count, generator);
+	input.SetSize(count);
+
+	auto result_types = Types(benchmark.result_type());
+	auto output = CreateChunk(std::move(result_types));
+
+	BenchmarkExecutor executor;
+	auto start = std::chrono::steady_clock::now();
+	for (idx_t executed = 0; executed < rows; executed += count) {
+		// Resetting the output releases the strings of the previous chunk, as DuckDB does between chunks.
+		duckdb_data_chunk_reset(output.c_data_chunk());
+		auto result = output.GetVector(0);
+		benchmark.execute(executor, input, result, count);
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+void PrintUsage(const char *program) {
+	fprintf(stderr, "Usage: %s [--rows N] [--repetitions N] [--filter NAME]\n", program);
+	fprintf(stderr, "Prints one CSV line per benchmark and parameter combination (the fastest repetition).\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	idx_t rows = 10000000;
+	idx_t repetitions = 3;
+	std::string filter;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (i + 1 < argc && arg == "--rows") {
+			rows = std::strtoull(argv[++i], nullptr, 10);
+		} else if (i + 1 < argc && arg == "--repetitions") {
+			repetitions = std::strtoull(argv[++i], nullptr, 10);
+		} else if (i + 1 < argc && arg == "--filter") {
+			filter = argv[++i];
+		} else {
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (rows == 0 || repetitions == 0) {
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	const double null_ratios[] = {0, 0.1, 0.5};
+	const idx_t string_lengths[] = {8, 32};
+	const bool constant_inputs[] = {false, true};
+
+	printf("benchmark,null_ratio,string_length,constant,rows,seconds,rows_per_second\n");
+	for (auto &benchmark : BENCHMARKS) {
+		if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos) {
+			continue;
+		}
+		for (auto null_ratio : null_ratios) {
+			for (auto string_length : string_lengths) {
+				if (!benchmark.uses_strings && string_length != string_lengths[0]) {
+					continue;
+				}
+				for (auto constant : constant_inputs) {
+					BenchmarkParameters parameters {null_ratio, benchmark.uses_strings ? string_length : 0, constant};
+					double seconds = 0;
+					for (idx_t repetition = 0; repetition < repetitions; repetition++) {
+						auto elapsed = RunBenchmark(benchmark, parameters, rows);
+						seconds = repetition == 0 ? elapsed : std::min(seconds, elapsed);
+					}
+					auto executed_rows = (rows + duckdb_vector_size() - 1) / duckdb_vector_size() * duckdb_vector_size();
+					printf("%s,%g,%llu,%s,%llu,%.6f,%.0f\n", benchmark.name, null_ratio,
+					       static_cast<unsigned long long>(parameters.string_length), constant ? "true" : "false",
+					       static_cast<unsigned long long>(executed_rows), seconds, executed_rows / seconds);
+					fflush(stdout);
+				}
+			}
+		}
+	}
+	return 0;
+}
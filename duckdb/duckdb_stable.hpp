@@ -1,15 +1,38 @@
+#include "duckdb/stable/allocator.hpp"
+#include "duckdb/stable/appender.hpp"
 #include "duckdb/stable/cast_function.hpp"
 #include "duckdb/stable/common.hpp"
+#include "duckdb/stable/custom_type.hpp"
 #include "duckdb/stable/data_chunk.hpp"
+#include "duckdb/stable/data_chunk_pool.hpp"
+#include "duckdb/stable/decimal_type.hpp"
+#include "duckdb/stable/enum_type.hpp"
 #include "duckdb/stable/exception.hpp"
 #include "duckdb/stable/executor.hpp"
 #include "duckdb/stable/executor_types.hpp"
 #include "duckdb/stable/extension_loader.hpp"
 #include "duckdb/stable/format.hpp"
+#include "duckdb/stable/function_overloads.hpp"
+#include "duckdb/stable/function_profiler.hpp"
+#include "duckdb/stable/fused_operator.hpp"
+#include "duckdb/stable/hash.hpp"
 #include "duckdb/stable/hugeint.hpp"
+#include "duckdb/stable/lazy_struct_type.hpp"
 #include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/lookup_table.hpp"
+#include "duckdb/stable/mapped_file.hpp"
+#include "duckdb/stable/memo_cache.hpp"
+#include "duckdb/stable/prefetch_reader.hpp"
+#include "duckdb/stable/prepared_statement.hpp"
+#include "duckdb/stable/query_result.hpp"
+#include "duckdb/stable/registration_builder.hpp"
+#include "duckdb/stable/replacement_scan.hpp"
 #include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/scalar_function_info.hpp"
+#include "duckdb/stable/string_kernels.hpp"
 #include "duckdb/stable/string_type.hpp"
 #include "duckdb/stable/string_util.hpp"
+#include "duckdb/stable/table_function.hpp"
 #include "duckdb/stable/uhugeint.hpp"
+#include "duckdb/stable/validity_mask.hpp"
 #include "duckdb/stable/vector.hpp"
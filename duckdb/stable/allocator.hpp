@@ -0,0 +1,407 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/allocator.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! Memory allocated with duckdb_malloc comes from the heap of the DuckDB library rather than from the heap of the
+//! extension, which can be linked against a different C runtime. Note that DuckDB does not charge these allocations
+//! against its memory_limit - the limit only covers its buffer manager - so large state belongs in DuckDB vectors.
+struct DuckDBMemory {
+	static void *Allocate(idx_t size) {
+		auto ptr = duckdb_malloc(size);
+		if (!ptr && size > 0) {
+			throw std::bad_alloc();
+		}
+		return ptr;
+	}
+
+	static void Free(void *ptr) {
+		duckdb_free(ptr);
+	}
+};
+
+//! An STL allocator that allocates through duckdb_malloc.
+template <class T>
+class DuckDBAllocator {
+public:
+	using value_type = T;
+
+	DuckDBAllocator() noexcept = default;
+	template <class U>
+	DuckDBAllocator(const DuckDBAllocator<U> &) noexcept { // NOLINT: allow implicit conversion.
+	}
+
+public:
+	T *allocate(std::size_t n) { // NOLINT: match the standard allocator naming.
+		if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+		return static_cast<T *>(DuckDBMemory::Allocate(n * sizeof(T)));
+	}
+	void deallocate(T *ptr, std::size_t) noexcept { // NOLINT: match the standard allocator naming.
+		DuckDBMemory::Free(ptr);
+	}
+};
+
+template <class T, class U>
+bool operator==(const DuckDBAllocator<T> &, const DuckDBAllocator<U> &) {
+	return true;
+}
+
+template <class T, class U>
+bool operator!=(const DuckDBAllocator<T> &, const DuckDBAllocator<U> &) {
+	return false;
+}
+
+struct SizeClassPoolStatistics {
+	//! Blocks allocated with duckdb_malloc because the free list of their size class was empty.
+	idx_t allocated = 0;
+	//! Blocks handed out from a free list.
+	idx_t reused = 0;
+	//! Blocks handed back to a free list.
+	idx_t returned = 0;
+	//! Blocks freed because the free list of their size class was already full.
+	idx_t freed = 0;
+};
+
+//! Caches freed small blocks in power-of-two size classes (16 bytes to 1KB), so that the short-lived scratch
+//! allocations of a function do not go to the system allocator for every row. Each class keeps an intrusive free
+//! list of at most max_cached_blocks blocks.
+//! A pool is not thread-safe - ThreadLocal() returns a separate pool for every thread, so threads never contend.
+//! Blocks may be freed into a different pool than the one they came from.
+class SizeClassPool {
+public:
+	static constexpr idx_t MIN_BLOCK_SIZE = 16;
+	static constexpr idx_t MAX_BLOCK_SIZE = 1024;
+	static constexpr idx_t SIZE_CLASS_COUNT = 7;
+	static constexpr idx_t DEFAULT_MAX_CACHED_BLOCKS = 256;
+
+	explicit SizeClassPool(idx_t max_cached_blocks_p = DEFAULT_MAX_CACHED_BLOCKS)
+	    : max_cached_blocks(max_cached_blocks_p) {
+		for (idx_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+			free_lists[c] = nullptr;
+			cached_blocks[c] = 0;
+		}
+	}
+	~SizeClassPool() {
+		Clear();
+	}
+
+	//! Disable copy constructors.
+	SizeClassPool(const SizeClassPool &other) = delete;
+	SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+public:
+	//! Allocate a block of at least size bytes. Sizes above MAX_BLOCK_SIZE go to duckdb_malloc directly.
+	void *Allocate(idx_t size) {
+		if (size > MAX_BLOCK_SIZE) {
+			return DuckDBMemory::Allocate(size);
+		}
+		auto size_class = SizeClass(size);
+		auto block = free_lists[size_class];
+		if (!block) {
+			statistics.allocated++;
+			return DuckDBMemory::Allocate(ClassSize(size_class));
+		}
+		free_lists[size_class] = block->next;
+		cached_blocks[size_class]--;
+		statistics.reused++;
+		return block;
+	}
+
+	//! Free a block - size must be the size it was allocated with.
+	void Free(void *ptr, idx_t size) {
+		if (!ptr) {
+			return;
+		}
+		if (size > MAX_BLOCK_SIZE) {
+			DuckDBMemory::Free(ptr);
+			return;
+		}
+		auto size_class = SizeClass(size);
+		if (cached_blocks[size_class] >= max_cached_blocks) {
+			statistics.freed++;
+			DuckDBMemory::Free(ptr);
+			return;
+		}
+		auto block = static_cast<FreeBlock *>(ptr);
+		block->next = free_lists[size_class];
+		free_lists[size_class] = block;
+		cached_blocks[size_class]++;
+		statistics.returned++;
+	}
+
+	//! Free all cached blocks.
+	void Clear() {
+		for (idx_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+			while (free_lists[c]) {
+				auto next = free_lists[c]->next;
+				DuckDBMemory::Free(free_lists[c]);
+				free_lists[c] = next;
+			}
+			cached_blocks[c] = 0;
+		}
+	}
+
+	idx_t CachedBytes() const {
+		idx_t bytes = 0;
+		for (idx_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+			bytes += cached_blocks[c] * ClassSize(c);
+		}
+		return bytes;
+	}
+
+	const SizeClassPoolStatistics &Statistics() const {
+		return statistics;
+	}
+
+	//! The pool of the calling thread. Its cached blocks are freed when the thread exits, containers that allocate
+	//! from it must therefore not be destroyed after the thread-local pool (e.g. in a static destructor).
+	static SizeClassPool &ThreadLocal() {
+		static thread_local SizeClassPool pool;
+		return pool;
+	}
+
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	static idx_t SizeClass(idx_t size) {
+		idx_t size_class = 0;
+		while (ClassSize(size_class) < size) {
+			size_class++;
+		}
+		return size_class;
+	}
+
+	static idx_t ClassSize(idx_t size_class) {
+		return MIN_BLOCK_SIZE << size_class;
+	}
+
+private:
+	idx_t max_cached_blocks;
+	FreeBlock *free_lists[SIZE_CLASS_COUNT];
+	idx_t cached_blocks[SIZE_CLASS_COUNT];
+	SizeClassPoolStatistics statistics;
+};
+
+//! An STL allocator that serves small allocations from the size class pool of the calling thread and larger ones
+//! from duckdb_malloc.
+template <class T>
+class PoolAllocator {
+public:
+	using value_type = T;
+
+	PoolAllocator() noexcept = default;
+	template <class U>
+	PoolAllocator(const PoolAllocator<U> &) noexcept { // NOLINT: allow implicit conversion.
+	}
+
+public:
+	T *allocate(std::size_t n) { // NOLINT: match the standard allocator naming.
+		if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+		return static_cast<T *>(SizeClassPool::ThreadLocal().Allocate(n * sizeof(T)));
+	}
+	void deallocate(T *ptr, std::size_t n) noexcept { // NOLINT: match the standard allocator naming.
+		SizeClassPool::ThreadLocal().Free(ptr, n * sizeof(T));
+	}
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) {
+	return true;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) {
+	return false;
+}
+
+template <class T>
+using PoolVector = std::vector<T, PoolAllocator<T>>;
+using PoolString = std::basic_string<char, std::char_traits<char>, PoolAllocator<char>>;
+
+//! Hands out memory from large blocks allocated with duckdb_malloc. Individual allocations are never freed - all of
+//! them are released at once by Reset() or on destruction, which makes the arena a good fit for scratch state that
+//! lives for a single chunk. Blocks double in size up to MAX_BLOCK_SIZE. An arena is not thread-safe.
+class ArenaAllocator {
+public:
+	static constexpr idx_t DEFAULT_BLOCK_SIZE = 16384;
+	static constexpr idx_t MAX_BLOCK_SIZE = 1048576;
+
+	explicit ArenaAllocator(idx_t initial_block_size_p = DEFAULT_BLOCK_SIZE)
+	    : initial_block_size(initial_block_size_p), head(nullptr), offset(0) {
+	}
+	~ArenaAllocator() {
+		Destroy();
+	}
+
+	//! Disable copy constructors.
+	ArenaAllocator(const ArenaAllocator &other) = delete;
+	ArenaAllocator &operator=(const ArenaAllocator &) = delete;
+
+	//! Enable move constructors.
+	ArenaAllocator(ArenaAllocator &&other) noexcept
+	    : initial_block_size(other.initial_block_size), head(nullptr), offset(0) {
+		std::swap(head, other.head);
+		std::swap(offset, other.offset);
+	}
+	ArenaAllocator &operator=(ArenaAllocator &&other) noexcept {
+		std::swap(initial_block_size, other.initial_block_size);
+		std::swap(head, other.head);
+		std::swap(offset, other.offset);
+		return *this;
+	}
+
+public:
+	//! Allocate size bytes with the given alignment (a power of two, at most that of std::max_align_t).
+	void *Allocate(idx_t size, idx_t alignment = alignof(std::max_align_t)) {
+		auto aligned_offset = (offset + alignment - 1) & ~(alignment - 1);
+		if (!head || aligned_offset + size > head->size) {
+			auto block_size = head ? head->size * 2 : initial_block_size;
+			if (block_size > MAX_BLOCK_SIZE) {
+				block_size = MAX_BLOCK_SIZE;
+			}
+			if (block_size < size) {
+				block_size = size;
+			}
+			AllocateBlock(block_size);
+			aligned_offset = 0;
+		}
+		auto result = head->Data() + aligned_offset;
+		offset = aligned_offset + size;
+		return result;
+	}
+
+	//! Copy a string into the arena.
+	char *AllocateString(const char *data, idx_t size) {
+		auto result = static_cast<char *>(Allocate(size, 1));
+		memcpy(result, data, size);
+		return result;
+	}
+
+	//! Release all allocations. The most recent (largest) block is kept for reuse, all others are freed.
+	void Reset() {
+		if (!head) {
+			return;
+		}
+		auto block = head->previous;
+		while (block) {
+			auto previous = block->previous;
+			DuckDBMemory::Free(block);
+			block = previous;
+		}
+		head->previous = nullptr;
+		offset = 0;
+	}
+
+	//! Free all blocks.
+	void Destroy() {
+		while (head) {
+			auto previous = head->previous;
+			DuckDBMemory::Free(head);
+			head = previous;
+		}
+		offset = 0;
+	}
+
+	//! The total size of the blocks held by the arena.
+	idx_t AllocatedBytes() const {
+		idx_t bytes = 0;
+		for (auto block = head; block; block = block->previous) {
+			bytes += block->size;
+		}
+		return bytes;
+	}
+
+private:
+	struct Block {
+		Block *previous;
+		idx_t size;
+		//! Pads the header so that the data that follows it has max_align_t alignment.
+		alignas(std::max_align_t) char data[1];
+
+		char *Data() {
+			return data;
+		}
+	};
+
+	void AllocateBlock(idx_t size) {
+		auto block = static_cast<Block *>(DuckDBMemory::Allocate(offsetof(Block, data) + size));
+		block->previous = head;
+		block->size = size;
+		head = block;
+		offset = 0;
+	}
+
+private:
+	idx_t initial_block_size;
+	//! The block that is currently allocated from - the blocks form a list through Block::previous.
+	Block *head;
+	idx_t offset;
+};
+
+//! An STL allocator that allocates from an arena. Deallocation is a no-op, the memory is released with the arena.
+template <class T>
+class ArenaStlAllocator {
+public:
+	using value_type = T;
+
+	explicit ArenaStlAllocator(ArenaAllocator &arena_p) noexcept : arena(&arena_p) {
+	}
+	template <class U>
+	ArenaStlAllocator(const ArenaStlAllocator<U> &other) noexcept : arena(other.arena) { // NOLINT: allow conversion.
+	}
+
+public:
+	T *allocate(std::size_t n) { // NOLINT: match the standard allocator naming.
+		if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+		return static_cast<T *>(arena->Allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T *, std::size_t) noexcept { // NOLINT: match the standard allocator naming.
+	}
+
+	ArenaAllocator &Arena() const {
+		return *arena;
+	}
+
+private:
+	template <class U>
+	friend class ArenaStlAllocator;
+
+	ArenaAllocator *arena;
+};
+
+template <class T, class U>
+bool operator==(const ArenaStlAllocator<T> &a, const ArenaStlAllocator<U> &b) {
+	return &a.Arena() == &b.Arena();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaStlAllocator<T> &a, const ArenaStlAllocator<U> &b) {
+	return !(a == b);
+}
+
+} // namespace duckdb_stable
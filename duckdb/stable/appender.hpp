@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/appender.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/data_chunk.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/vector.hpp"
+
+#include <string>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! The Appender buffers rows in a single DataChunk and pushes it to DuckDB with duckdb_append_data_chunk once it is
+//! full. Values are written with the same executor types (e.g. PrimitiveType<int32_t>) that are used for functions.
+//! The chunk is reset and re-used after every flush, so steady-state appending does not allocate.
+class Appender {
+public:
+	Appender(duckdb_connection con, const char *schema, const char *table)
+	    : appender(nullptr), chunk(nullptr), capacity(duckdb_vector_size()), row(0), column(0) {
+		if (duckdb_appender_create(con, schema, table, &appender) != DuckDBSuccess) {
+			std::string error = GetError();
+			duckdb_appender_destroy(&appender);
+			throw Exception(std::string("Failed to create appender for table ") + table + ": " + error);
+		}
+		auto column_count = duckdb_appender_column_count(appender);
+		std::vector<duckdb_logical_type> c_types;
+		for (idx_t i = 0; i < column_count; i++) {
+			types.emplace_back(duckdb_appender_column_type(appender, i));
+			c_types.push_back(types.back().c_logical_type());
+		}
+		chunk = DataChunk(duckdb_create_data_chunk(c_types.data(), column_count), true);
+		for (idx_t i = 0; i < column_count; i++) {
+			columns.push_back(chunk.GetVector(i));
+		}
+		checked_types.resize(column_count, nullptr);
+	}
+	~Appender() {
+		if (!appender) {
+			return;
+		}
+		try {
+			// Appends the complete rows, a partially written row is dropped.
+			FlushChunk();
+		} catch (...) { // NOLINT: destructors cannot throw, the appender is destroyed regardless.
+		}
+		duckdb_appender_destroy(&appender);
+	}
+
+	//! Disable copy constructors.
+	Appender(const Appender &other) = delete;
+	Appender &operator=(const Appender &) = delete;
+
+public:
+	//! Write a value to the next column of the current row. Throws if the column does not store values of TYPE.
+	template <class TYPE>
+	void Append(const typename TYPE::ARG_TYPE &val) {
+		auto &result = NextColumn<TYPE>();
+		TYPE::AssignResult(result, row, val);
+	}
+
+	//! Write a NULL to the next column of the current row.
+	template <class TYPE>
+	void AppendNull() {
+		auto &result = NextColumn<TYPE>();
+		typename TYPE::STRUCT_STATE result_state;
+		TYPE::SetNull(result, result_state, row);
+	}
+
+	//! Finish the current row - every column must have been written. Pushes the chunk to DuckDB once it is full.
+	void EndRow() {
+		if (column != columns.size()) {
+			throw Exception(
+			    Exception::ConstructMessage("Appender row ended after {} of {} columns", column, columns.size()));
+		}
+		column = 0;
+		row++;
+		if (row == capacity) {
+			FlushChunk();
+		}
+	}
+
+	//! Append a complete chunk directly, any buffered rows are pushed first to preserve the row order.
+	void AppendDataChunk(DataChunk &input) {
+		FlushChunk();
+		if (duckdb_append_data_chunk(appender, input.c_data_chunk()) != DuckDBSuccess) {
+			throw Exception(std::string("Failed to append data chunk: ") + GetError());
+		}
+	}
+
+	//! Push the buffered rows and flush the appender to the table.
+	void Flush() {
+		FlushChunk();
+		if (duckdb_appender_flush(appender) != DuckDBSuccess) {
+			throw Exception(std::string("Failed to flush appender: ") + GetError());
+		}
+	}
+
+	//! Flush and close the appender, after which no more rows can be appended.
+	void Close() {
+		FlushChunk();
+		if (duckdb_appender_close(appender) != DuckDBSuccess) {
+			throw Exception(std::string("Failed to close appender: ") + GetError());
+		}
+	}
+
+	idx_t ColumnCount() const {
+		return columns.size();
+	}
+
+public:
+	duckdb_appender c_appender() {
+		return appender;
+	}
+
+private:
+	template <class TYPE>
+	Vector &NextColumn() {
+		if (column >= columns.size()) {
+			throw Exception(Exception::ConstructMessage("Appender row has only {} columns", columns.size()));
+		}
+		// The type is checked the first time it is written to the column, and again whenever it changes.
+		if (checked_types[column] != TypeTag<TYPE>()) {
+			if (!TypeMatchesLogicalType<TYPE>::Matches(types[column].c_logical_type())) {
+				throw Exception(Exception::ConstructMessage(
+				    "Appender column {} does not store values of the appended type", column));
+			}
+			checked_types[column] = TypeTag<TYPE>();
+		}
+		return columns[column++];
+	}
+
+	template <class TYPE>
+	static const void *TypeTag() {
+		static const char tag = 0;
+		return &tag;
+	}
+
+	//! Pushes the complete rows. A partially written row is dropped after that, and reported.
+	void FlushChunk() {
+		auto partial_row = column != 0;
+		column = 0;
+		auto success = true;
+		if (row > 0) {
+			chunk.SetSize(row);
+			success = duckdb_append_data_chunk(appender, chunk.c_data_chunk()) == DuckDBSuccess;
+			// The vectors (and their buffers) are kept alive by the reset, so the cached handles remain valid.
+			duckdb_data_chunk_reset(chunk.c_data_chunk());
+			row = 0;
+		}
+		if (!success) {
+			throw Exception(std::string("Failed to append data chunk: ") + GetError());
+		}
+		if (partial_row) {
+			throw Exception("Appender flushed while a row was partially written, the partial row was dropped");
+		}
+	}
+
+	std::string GetError() {
+		auto error = duckdb_appender_error(appender);
+		return error ? error : "unknown error";
+	}
+
+private:
+	duckdb_appender appender;
+	DataChunk chunk;
+	std::vector<LogicalType> types;
+	std::vector<Vector> columns;
+	//! The executor type each column was last checked against, see NextColumn.
+	std::vector<const void *> checked_types;
+	idx_t capacity;
+	idx_t row;
+	idx_t column;
+};
+
+} // namespace duckdb_stable
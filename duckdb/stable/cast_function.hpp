@@ -15,6 +15,38 @@
 
 namespace duckdb_stable {
 
+class CCastFunction {
+public:
+	CCastFunction(duckdb_cast_function function_p) : function(function_p) {
+	}
+	~CCastFunction() {
+		if (function) {
+			duckdb_destroy_cast_function(&function);
+		}
+	}
+
+	//! Disable copy constructors.
+	CCastFunction(const CCastFunction &other) = delete;
+	CCastFunction &operator=(const CCastFunction &) = delete;
+
+	//! Enable move constructors.
+	CCastFunction(CCastFunction &&other) noexcept : function(nullptr) {
+		std::swap(function, other.function);
+	}
+	CCastFunction &operator=(CCastFunction &&other) noexcept {
+		std::swap(function, other.function);
+		return *this;
+	}
+
+public:
+	duckdb_cast_function c_cast_function() {
+		return function;
+	}
+
+private:
+	duckdb_cast_function function;
+};
+
 class CastFunction {
 public:
 	virtual ~CastFunction() = default;
@@ -23,17 +55,26 @@ public:
 	virtual LogicalType TargetType() = 0;
 	virtual int64_t ImplicitCastCost() = 0;
 	virtual duckdb_cast_function_t GetFunction() = 0;
+
+	CCastFunction CreateFunction() {
+		auto cast_function = duckdb_create_cast_function();
+		duckdb_cast_function_set_implicit_cast_cost(cast_function, ImplicitCastCost());
+		duckdb_cast_function_set_source_type(cast_function, SourceType().c_logical_type());
+		duckdb_cast_function_set_target_type(cast_function, TargetType().c_logical_type());
+		duckdb_cast_function_set_function(cast_function, GetFunction());
+		return CCastFunction(cast_function);
+	}
 };
 
 template <class SOURCE_TYPE, class TARGET_TYPE>
 class BaseCastFunction : public CastFunction {
 public:
 	LogicalType SourceType() override {
-		return TemplateToType::Convert<SOURCE_TYPE>();
+		return TemplateToType::Intern<SOURCE_TYPE>();
 	}
 
 	LogicalType TargetType() override {
-		return TemplateToType::Convert<TARGET_TYPE>();
+		return TemplateToType::Intern<TARGET_TYPE>();
 	}
 };
 
@@ -0,0 +1,193 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/custom_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/cast_function.hpp"
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/registration_builder.hpp"
+#include "duckdb/stable/string_type.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace duckdb_stable {
+
+//! A BLOB value, viewed where it is stored in the vector. Custom types derive their view from it and read the fields
+//! they need with Load, which copies only those bytes (BLOB data has no alignment guarantees).
+class BlobView {
+public:
+	BlobView() = default;
+	explicit BlobView(string_t blob_p) : blob(blob_p) {
+	}
+
+public:
+	const char *Data() const {
+		return blob.GetData();
+	}
+	idx_t Size() const {
+		return blob.GetSize();
+	}
+	string_t Storage() const {
+		return blob;
+	}
+
+	template <class T>
+	T Load(idx_t offset) const {
+		T result;
+		memcpy(&result, Data() + offset, sizeof(T));
+		return result;
+	}
+
+	//! Appends the bytes of the value, in native byte order, to an encoding that is being built.
+	template <class T>
+	static void Append(std::string &buffer, T value) {
+		buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+protected:
+	string_t blob;
+};
+
+//! The executor type of a custom type: a BLOB (or fixed-width) storage type with an alias. The values are decoded
+//! from VARCHAR once by the cast the type is registered with, functions then receive a view on the stored encoding
+//! instead of parsing text on every call. TRAITS provides:
+//!
+//! - static const char *Name(): the alias of the type.
+//! - STORAGE_TYPE: string_t for a BLOB-backed type, or a fixed-width type (e.g. uint64_t, hugeint_t).
+//! - VIEW: the ARG_TYPE, constructible from STORAGE_TYPE with "STORAGE_TYPE Storage() const" (see BlobView).
+//! - static VIEW Parse(const string_t &text, std::string &buffer): the VARCHAR -> type cast. BLOB-backed types encode
+//!   into the (empty) buffer and return a view on it. Throws on invalid input.
+//! - static void Format(const VIEW &value, std::string &buffer): the type -> VARCHAR cast, appends the text.
+template <class TRAITS>
+struct CustomType {
+	using STORAGE_TYPE = typename TRAITS::STORAGE_TYPE;
+	using ARG_TYPE = typename TRAITS::VIEW;
+	using STRUCT_STATE = PrimitiveTypeState<STORAGE_TYPE>;
+
+	static void ConstructType(STRUCT_STATE &state, idx_t r, ARG_TYPE &output) {
+		output = ARG_TYPE(state.data[r]);
+	}
+
+	static void SetNull(Vector &result, STRUCT_STATE &result_state, idx_t r) {
+		ValidityMask::SetInvalid(result, result_state.validity, r);
+	}
+
+	static void AssignResult(Vector &result, idx_t r, const ARG_TYPE &result_val) {
+		AssignResult::Assign<STORAGE_TYPE>(result, r, result_val.Storage());
+	}
+
+	static LogicalType CreateLogicalType() {
+		auto type = CreateStorageType(std::is_same<STORAGE_TYPE, string_t>());
+		type.SetAlias(TRAITS::Name());
+		return type;
+	}
+
+private:
+	static LogicalType CreateStorageType(std::true_type) {
+		return LogicalType(DUCKDB_TYPE_BLOB);
+	}
+	static LogicalType CreateStorageType(std::false_type) {
+		return TemplateToType::Convert<PrimitiveType<STORAGE_TYPE>>();
+	}
+};
+
+//! The encoding or text of the row that is being cast, reused across the rows of a chunk.
+struct CustomTypeCastBuffer {
+	std::string buffer;
+};
+
+template <class TRAITS>
+struct CustomTypeParseOperator {
+	static typename TRAITS::VIEW Cast(const string_t &input, CustomTypeCastBuffer &data) {
+		data.buffer.clear();
+		return TRAITS::Parse(input, data.buffer);
+	}
+};
+
+template <class TRAITS>
+struct CustomTypeFormatOperator {
+	static string_t Cast(const typename TRAITS::VIEW &input, CustomTypeCastBuffer &data) {
+		data.buffer.clear();
+		TRAITS::Format(input, data.buffer);
+		return string_t(data.buffer.data(), static_cast<uint32_t>(data.buffer.size()));
+	}
+};
+
+//! VARCHAR -> custom type, with TRAITS::Parse.
+template <class TRAITS>
+class CustomTypeFromVarcharCast
+    : public StandardCastFunctionExt<CustomTypeParseOperator<TRAITS>, PrimitiveType<string_t>, CustomType<TRAITS>,
+                                     CustomTypeCastBuffer> {
+public:
+	//! Explicit-only by default (-1). String literals are still converted when compared with or inserted into the type.
+	explicit CustomTypeFromVarcharCast(int64_t implicit_cast_cost_p = -1) : implicit_cast_cost(implicit_cast_cost_p) {
+	}
+
+	int64_t ImplicitCastCost() override {
+		return implicit_cast_cost;
+	}
+
+private:
+	int64_t implicit_cast_cost;
+};
+
+//! Custom type -> VARCHAR, with TRAITS::Format.
+template <class TRAITS>
+class CustomTypeToVarcharCast
+    : public StandardCastFunctionExt<CustomTypeFormatOperator<TRAITS>, CustomType<TRAITS>, PrimitiveType<string_t>,
+                                     CustomTypeCastBuffer> {
+public:
+	explicit CustomTypeToVarcharCast(int64_t implicit_cast_cost_p = -1) : implicit_cast_cost(implicit_cast_cost_p) {
+	}
+
+	int64_t ImplicitCastCost() override {
+		return implicit_cast_cost;
+	}
+
+private:
+	int64_t implicit_cast_cost;
+};
+
+//! A custom type together with its casts from and to VARCHAR, which must stay alive until they are registered.
+template <class TRAITS>
+class CustomTypeRegistration {
+public:
+	CustomTypeRegistration() : type(CustomType<TRAITS>::CreateLogicalType()) {
+	}
+
+	//! Disable copy constructors.
+	CustomTypeRegistration(const CustomTypeRegistration &other) = delete;
+	CustomTypeRegistration &operator=(const CustomTypeRegistration &) = delete;
+
+public:
+	RegistrationBuilder &AddTo(RegistrationBuilder &builder) {
+		return builder.AddType(type).AddCast(from_varchar).AddCast(to_varchar);
+	}
+
+	LogicalType &GetType() {
+		return type;
+	}
+	CustomTypeFromVarcharCast<TRAITS> &FromVarchar() {
+		return from_varchar;
+	}
+	CustomTypeToVarcharCast<TRAITS> &ToVarchar() {
+		return to_varchar;
+	}
+
+private:
+	LogicalType type;
+	CustomTypeFromVarcharCast<TRAITS> from_varchar;
+	CustomTypeToVarcharCast<TRAITS> to_varchar;
+};
+
+} // namespace duckdb_stable
@@ -46,6 +46,10 @@ public:
 		return duckdb_data_chunk_get_size(chunk);
 	}
 
+	void SetSize(const idx_t size) {
+		duckdb_data_chunk_set_size(chunk, size);
+	}
+
 	idx_t ColumnCount() const {
 		return duckdb_data_chunk_get_column_count(chunk);
 	}
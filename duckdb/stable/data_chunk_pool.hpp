@@ -0,0 +1,279 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/data_chunk_pool.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/data_chunk.hpp"
+#include "duckdb/stable/logical_type.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! The column types of pooled chunks. The key that identifies the schema in a pool is computed once on construction,
+//! so looking up chunks for a schema does not have to inspect the types again.
+class ChunkSchema {
+public:
+	explicit ChunkSchema(std::vector<LogicalType> types_p) : types(std::move(types_p)) {
+		for (auto &type : types) {
+			c_types.push_back(type.c_logical_type());
+			AppendTypeKey(type, key);
+			key += ';';
+		}
+	}
+
+public:
+	const std::string &Key() const {
+		return key;
+	}
+
+	idx_t ColumnCount() const {
+		return types.size();
+	}
+
+	duckdb_data_chunk CreateChunk() {
+		return duckdb_create_data_chunk(c_types.data(), c_types.size());
+	}
+
+private:
+	static void AppendName(char *name, std::string &key) {
+		std::string str(name ? name : "");
+		key += std::to_string(str.size()) + ':' + str;
+		if (name) {
+			duckdb_free(name);
+		}
+	}
+
+	static void AppendTypeKey(LogicalType &type, std::string &key) {
+		auto c_type = type.c_logical_type();
+		auto type_id = type.c_type();
+		key += std::to_string(static_cast<int>(type_id));
+		auto alias = duckdb_logical_type_get_alias(c_type);
+		if (alias) {
+			key += '@';
+			AppendName(alias, key);
+		}
+		switch (type_id) {
+		case DUCKDB_TYPE_DECIMAL:
+			key += '(' + std::to_string(duckdb_decimal_width(c_type)) + ',' +
+			       std::to_string(duckdb_decimal_scale(c_type)) + ')';
+			break;
+		case DUCKDB_TYPE_ENUM: {
+			key += '(';
+			auto size = duckdb_enum_dictionary_size(c_type);
+			for (idx_t i = 0; i < size; i++) {
+				AppendName(duckdb_enum_dictionary_value(c_type, i), key);
+			}
+			key += ')';
+			break;
+		}
+		case DUCKDB_TYPE_LIST: {
+			LogicalType child(duckdb_list_type_child_type(c_type));
+			key += '[';
+			AppendTypeKey(child, key);
+			key += ']';
+			break;
+		}
+		case DUCKDB_TYPE_ARRAY: {
+			LogicalType child(duckdb_array_type_child_type(c_type));
+			key += '[';
+			AppendTypeKey(child, key);
+			key += ':' + std::to_string(duckdb_array_type_array_size(c_type)) + ']';
+			break;
+		}
+		case DUCKDB_TYPE_MAP: {
+			LogicalType key_type(duckdb_map_type_key_type(c_type));
+			LogicalType value_type(duckdb_map_type_value_type(c_type));
+			key += '(';
+			AppendTypeKey(key_type, key);
+			key += ',';
+			AppendTypeKey(value_type, key);
+			key += ')';
+			break;
+		}
+		case DUCKDB_TYPE_STRUCT: {
+			key += '(';
+			auto child_count = duckdb_struct_type_child_count(c_type);
+			for (idx_t i = 0; i < child_count; i++) {
+				AppendName(duckdb_struct_type_child_name(c_type, i), key);
+				LogicalType child(duckdb_struct_type_child_type(c_type, i));
+				AppendTypeKey(child, key);
+				key += ',';
+			}
+			key += ')';
+			break;
+		}
+		case DUCKDB_TYPE_UNION: {
+			key += '(';
+			auto member_count = duckdb_union_type_member_count(c_type);
+			for (idx_t i = 0; i < member_count; i++) {
+				AppendName(duckdb_union_type_member_name(c_type, i), key);
+				LogicalType member(duckdb_union_type_member_type(c_type, i));
+				AppendTypeKey(member, key);
+				key += ',';
+			}
+			key += ')';
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+private:
+	std::vector<LogicalType> types;
+	std::vector<duckdb_logical_type> c_types;
+	std::string key;
+};
+
+struct DataChunkPoolStatistics {
+	//! Chunks created because the pool held no chunk for the requested schema.
+	idx_t allocated = 0;
+	//! Chunks handed out from the pool instead of being created.
+	idx_t reused = 0;
+	//! Chunks reset and handed back to the pool.
+	idx_t returned = 0;
+	//! Chunks destroyed because the pool for their schema was already full.
+	idx_t destroyed = 0;
+};
+
+class DataChunkPool;
+
+//! A chunk borrowed from a DataChunkPool. The chunk is reset with duckdb_data_chunk_reset and handed back to the pool
+//! when the PooledDataChunk is destroyed, it must therefore not outlive (or be destroyed on another thread than) the
+//! pool it came from.
+class PooledDataChunk {
+public:
+	PooledDataChunk(DataChunkPool &pool_p, std::vector<duckdb_data_chunk> &free_list_p, duckdb_data_chunk chunk_p)
+	    : pool(&pool_p), free_list(&free_list_p), chunk(chunk_p) {
+	}
+	inline ~PooledDataChunk();
+
+	//! Disable copy constructors.
+	PooledDataChunk(const PooledDataChunk &other) = delete;
+	PooledDataChunk &operator=(const PooledDataChunk &) = delete;
+
+	//! Enable move constructors.
+	PooledDataChunk(PooledDataChunk &&other) noexcept
+	    : pool(other.pool), free_list(other.free_list), chunk(std::move(other.chunk)) {
+		other.pool = nullptr;
+	}
+
+public:
+	DataChunk &Chunk() {
+		return chunk;
+	}
+	DataChunk *operator->() {
+		return &chunk;
+	}
+
+private:
+	DataChunkPool *pool;
+	std::vector<duckdb_data_chunk> *free_list;
+	DataChunk chunk;
+};
+
+//! A pool of owning chunks keyed by their schema. Producers that emit a chunk per batch (table functions, appenders,
+//! scratch space) can borrow chunks from the pool instead of creating and destroying one every time. Scratch vectors
+//! can be pooled as single-column chunks.
+//! A pool is not thread-safe - ThreadLocal() returns a separate pool for every thread.
+class DataChunkPool {
+public:
+	static constexpr idx_t DEFAULT_MAX_POOLED_CHUNKS = 8;
+
+	explicit DataChunkPool(idx_t max_pooled_chunks_p = DEFAULT_MAX_POOLED_CHUNKS)
+	    : max_pooled_chunks(max_pooled_chunks_p) {
+	}
+	~DataChunkPool() {
+		Clear();
+	}
+
+	//! Disable copy constructors.
+	DataChunkPool(const DataChunkPool &other) = delete;
+	DataChunkPool &operator=(const DataChunkPool &) = delete;
+
+public:
+	//! Borrow an empty chunk with the given schema, creating one if none is pooled.
+	PooledDataChunk Get(ChunkSchema &schema) {
+		auto entry = pools.find(schema.Key());
+		if (entry == pools.end()) {
+			auto free_list = std::unique_ptr<std::vector<duckdb_data_chunk>>(new std::vector<duckdb_data_chunk>());
+			free_list->reserve(max_pooled_chunks);
+			entry = pools.emplace(schema.Key(), std::move(free_list)).first;
+		}
+		auto &free_list = *entry->second;
+		if (free_list.empty()) {
+			statistics.allocated++;
+			return PooledDataChunk(*this, free_list, schema.CreateChunk());
+		}
+		auto chunk = free_list.back();
+		free_list.pop_back();
+		statistics.reused++;
+		return PooledDataChunk(*this, free_list, chunk);
+	}
+
+	//! Destroy all pooled chunks.
+	void Clear() {
+		for (auto &entry : pools) {
+			for (auto &chunk : *entry.second) {
+				duckdb_destroy_data_chunk(&chunk);
+			}
+			entry.second->clear();
+		}
+	}
+
+	idx_t PooledChunkCount() const {
+		idx_t count = 0;
+		for (auto &entry : pools) {
+			count += entry.second->size();
+		}
+		return count;
+	}
+
+	const DataChunkPoolStatistics &Statistics() const {
+		return statistics;
+	}
+
+	//! The pool of the calling thread.
+	static DataChunkPool &ThreadLocal() {
+		static thread_local DataChunkPool pool;
+		return pool;
+	}
+
+private:
+	friend class PooledDataChunk;
+
+	void Return(std::vector<duckdb_data_chunk> &free_list, duckdb_data_chunk chunk) {
+		if (free_list.size() >= max_pooled_chunks) {
+			statistics.destroyed++;
+			duckdb_destroy_data_chunk(&chunk);
+			return;
+		}
+		statistics.returned++;
+		duckdb_data_chunk_reset(chunk);
+		free_list.push_back(chunk);
+	}
+
+private:
+	idx_t max_pooled_chunks;
+	//! The free lists are heap-allocated so that borrowed chunks can keep a stable reference to theirs.
+	std::unordered_map<std::string, std::unique_ptr<std::vector<duckdb_data_chunk>>> pools;
+	DataChunkPoolStatistics statistics;
+};
+
+PooledDataChunk::~PooledDataChunk() {
+	if (pool && chunk.c_data_chunk()) {
+		pool->Return(*free_list, chunk.c_data_chunk());
+	}
+}
+
+} // namespace duckdb_stable
@@ -0,0 +1,787 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/decimal_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/hugeint.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! The integer type that DuckDB stores a DECIMAL of the width as.
+template <uint8_t WIDTH>
+struct DecimalStorage {
+	using type = typename std::conditional<
+	    WIDTH <= 4, int16_t,
+	    typename std::conditional<WIDTH <= 9, int32_t,
+	                              typename std::conditional<WIDTH <= 18, int64_t, hugeint_t>::type>::type>::type;
+};
+
+//! The width and scale of a DECIMAL, for functions whose types are only known at runtime.
+struct DecimalFormat {
+	static constexpr uint8_t MAX_WIDTH = 38;
+
+	DecimalFormat(uint8_t width_p, uint8_t scale_p) : width(width_p), scale(scale_p) {
+		if (width < 1 || width > MAX_WIDTH || scale > width) {
+			throw Exception("Invalid DECIMAL(" + std::to_string(width) + "," + std::to_string(scale) + ")");
+		}
+	}
+
+	static DecimalFormat FromType(LogicalType &type) {
+		if (type.c_type() != DUCKDB_TYPE_DECIMAL) {
+			throw Exception("Not a DECIMAL type");
+		}
+		return DecimalFormat(duckdb_decimal_width(type.c_logical_type()), duckdb_decimal_scale(type.c_logical_type()));
+	}
+
+	//! The type that DuckDB stores the values as.
+	duckdb_type StorageType() const {
+		if (width <= 4) {
+			return DUCKDB_TYPE_SMALLINT;
+		}
+		if (width <= 9) {
+			return DUCKDB_TYPE_INTEGER;
+		}
+		if (width <= 18) {
+			return DUCKDB_TYPE_BIGINT;
+		}
+		return DUCKDB_TYPE_HUGEINT;
+	}
+
+	LogicalType CreateType() const {
+		return LogicalType::DECIMAL(width, scale);
+	}
+
+	std::string ToString() const {
+		return "DECIMAL(" + std::to_string(width) + "," + std::to_string(scale) + ")";
+	}
+
+	uint8_t width;
+	uint8_t scale;
+};
+
+template <class T>
+struct DecimalStorageType {};
+
+template <>
+struct DecimalStorageType<int16_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_SMALLINT;
+};
+
+template <>
+struct DecimalStorageType<int32_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_INTEGER;
+};
+
+template <>
+struct DecimalStorageType<int64_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_BIGINT;
+};
+
+template <>
+struct DecimalStorageType<hugeint_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_HUGEINT;
+};
+
+//! Checked fixed-point arithmetic on the integers that DECIMAL computations run on: int64_t and hugeint_t. Every
+//! operation returns false instead of overflowing.
+template <class T>
+struct DecimalArithmetic {};
+
+template <>
+struct DecimalArithmetic<int64_t> {
+	//! The largest power of ten that fits.
+	static constexpr idx_t MAX_DIGITS = 18;
+
+	static int64_t Power(idx_t digits) {
+		static const int64_t POWERS[] = {1LL,
+		                                 10LL,
+		                                 100LL,
+		                                 1000LL,
+		                                 10000LL,
+		                                 100000LL,
+		                                 1000000LL,
+		                                 10000000LL,
+		                                 100000000LL,
+		                                 1000000000LL,
+		                                 10000000000LL,
+		                                 100000000000LL,
+		                                 1000000000000LL,
+		                                 10000000000000LL,
+		                                 100000000000000LL,
+		                                 1000000000000000LL,
+		                                 10000000000000000LL,
+		                                 100000000000000000LL,
+		                                 1000000000000000000LL};
+		return POWERS[digits];
+	}
+
+	static bool TryAdd(int64_t lhs, int64_t rhs, int64_t &result) {
+		if ((rhs > 0 && lhs > std::numeric_limits<int64_t>::max() - rhs) ||
+		    (rhs < 0 && lhs < std::numeric_limits<int64_t>::min() - rhs)) {
+			return false;
+		}
+		result = lhs + rhs;
+		return true;
+	}
+
+	static bool TrySubtract(int64_t lhs, int64_t rhs, int64_t &result) {
+		if ((rhs < 0 && lhs > std::numeric_limits<int64_t>::max() + rhs) ||
+		    (rhs > 0 && lhs < std::numeric_limits<int64_t>::min() + rhs)) {
+			return false;
+		}
+		result = lhs - rhs;
+		return true;
+	}
+
+	static bool TryMultiply(int64_t lhs, int64_t rhs, int64_t &result) {
+#if defined(__GNUC__) || defined(__clang__)
+		return !__builtin_mul_overflow(lhs, rhs, &result);
+#else
+		hugeint_t product;
+		if (!hugeint_t::try_multiply(hugeint_t(lhs), hugeint_t(rhs), product)) {
+			return false;
+		}
+		auto upper = product.upper();
+		auto lower = product.lower();
+		if (upper != (static_cast<int64_t>(lower) < 0 ? -1 : 0)) {
+			return false;
+		}
+		result = static_cast<int64_t>(lower);
+		return true;
+#endif
+	}
+
+	static bool TryScaleUp(int64_t value, idx_t digits, int64_t &result) {
+		if (digits > MAX_DIGITS) {
+			result = 0;
+			return value == 0;
+		}
+		return TryMultiply(value, Power(digits), result);
+	}
+
+	//! Divides by 10^digits, rounding half away from zero like DuckDB.
+	static bool TryScaleDown(int64_t value, idx_t digits, int64_t &result) {
+		if (digits > MAX_DIGITS) {
+			// |value| < 9.3 * 10^18, which rounds to +-1 at 19 digits and to 0 beyond.
+			auto half = Power(MAX_DIGITS) * 5;
+			result = digits == MAX_DIGITS + 1 ? (value >= half ? 1 : (value <= -half ? -1 : 0)) : 0;
+			return true;
+		}
+		auto power = Power(digits);
+		result = value / power;
+		auto remainder = value % power;
+		if (remainder >= power / 2 && power > 1) {
+			result++;
+		} else if (remainder <= -(power / 2) && power > 1) {
+			result--;
+		}
+		return true;
+	}
+
+	//! Whether the value has at most "width" digits.
+	static bool InRange(int64_t value, idx_t width) {
+		if (width > MAX_DIGITS) {
+			return true;
+		}
+		auto limit = Power(width);
+		return value > -limit && value < limit;
+	}
+};
+
+template <>
+struct DecimalArithmetic<hugeint_t> {
+	static constexpr idx_t MAX_DIGITS = 38;
+
+	static hugeint_t Power(idx_t digits) {
+		static const PowerTable TABLE;
+		return TABLE.powers[digits];
+	}
+
+	static bool TryAdd(hugeint_t lhs, hugeint_t rhs, hugeint_t &result) {
+		if (!hugeint_t::try_add_in_place(lhs, rhs)) {
+			return false;
+		}
+		result = lhs;
+		return true;
+	}
+
+	static bool TrySubtract(hugeint_t lhs, hugeint_t rhs, hugeint_t &result) {
+		if (!hugeint_t::try_subtract_in_place(lhs, rhs)) {
+			return false;
+		}
+		result = lhs;
+		return true;
+	}
+
+	static bool TryMultiply(hugeint_t lhs, hugeint_t rhs, hugeint_t &result) {
+		return hugeint_t::try_multiply(lhs, rhs, result);
+	}
+
+	static bool TryScaleUp(hugeint_t value, idx_t digits, hugeint_t &result) {
+		if (digits > MAX_DIGITS) {
+			result = hugeint_t(0);
+			return value == hugeint_t(0);
+		}
+		return TryMultiply(value, Power(digits), result);
+	}
+
+	//! Divides by 10^digits, rounding half away from zero like DuckDB.
+	static bool TryScaleDown(hugeint_t value, idx_t digits, hugeint_t &result) {
+		if (digits == 0) {
+			result = value;
+			return true;
+		}
+		if (digits > MAX_DIGITS) {
+			// |value| < 1.8 * 10^38, which rounds to 0.
+			result = hugeint_t(0);
+			return true;
+		}
+		// Rounding half away from zero is adding half of the divisor before truncating.
+		auto half = Power(digits - 1).multiply(hugeint_t(5));
+		auto negative = value < hugeint_t(0);
+		if (negative ? !hugeint_t::try_subtract_in_place(value, half) : !hugeint_t::try_add_in_place(value, half)) {
+			return false;
+		}
+		// Truncating in steps of 10^9 truncates as a whole, as the steps multiply up to the divisor.
+		uint32_t remainder;
+		for (; digits >= 9; digits -= 9) {
+			value = value.divide(1000000000, remainder);
+		}
+		if (digits > 0) {
+			value = value.divide(static_cast<uint32_t>(DecimalArithmetic<int64_t>::Power(digits)), remainder);
+		}
+		result = value;
+		return true;
+	}
+
+	static bool InRange(hugeint_t value, idx_t width) {
+		if (width > MAX_DIGITS) {
+			return true;
+		}
+		auto limit = Power(width);
+		return value < limit && limit.negate() < value;
+	}
+
+private:
+	struct PowerTable {
+		PowerTable() {
+			powers[0] = hugeint_t(1);
+			for (idx_t i = 1; i <= MAX_DIGITS; i++) {
+				powers[i] = powers[i - 1].multiply(hugeint_t(10));
+			}
+		}
+		hugeint_t powers[MAX_DIGITS + 1];
+	};
+};
+
+//! Conversions between the storage types of DECIMAL values, which fail when the value does not fit.
+struct DecimalConvert {
+	template <class FROM, class TO>
+	static bool Try(FROM value, TO &result) {
+		if (value < std::numeric_limits<TO>::min() || value > std::numeric_limits<TO>::max()) {
+			return false;
+		}
+		result = static_cast<TO>(value);
+		return true;
+	}
+
+	template <class TO>
+	static bool Try(hugeint_t value, TO &result) {
+		auto lower = static_cast<int64_t>(value.lower());
+		if (value.upper() != (lower < 0 ? -1 : 0)) {
+			return false;
+		}
+		return Try<int64_t, TO>(lower, result);
+	}
+
+	template <class FROM>
+	static bool Try(FROM value, hugeint_t &result) {
+		result = hugeint_t(static_cast<int64_t>(value));
+		return true;
+	}
+
+	static bool Try(hugeint_t value, hugeint_t &result) {
+		result = value;
+		return true;
+	}
+};
+
+//! Renders a stored DECIMAL value, e.g. 12345 with scale 2 as "123.45".
+template <class T>
+inline std::string DecimalToString(T value, uint8_t scale) {
+	hugeint_t remaining;
+	DecimalConvert::Try(value, remaining);
+	auto negative = remaining < hugeint_t(0);
+	std::string digits;
+	uint32_t digit;
+	do {
+		remaining = remaining.divide(10, digit);
+		digits.insert(digits.begin(), static_cast<char>('0' + digit));
+	} while (remaining != hugeint_t(0));
+	if (scale > 0) {
+		if (digits.size() <= scale) {
+			digits.insert(0, scale + 1 - digits.size(), '0');
+		}
+		digits.insert(digits.size() - scale, 1, '.');
+	}
+	return negative ? "-" + digits : digits;
+}
+
+//! The checked kernels on DECIMAL values, for any combination of storage types. INTERMEDIATE (int64_t or hugeint_t)
+//! is what the computation runs on - it must be able to hold the inputs at the scale they are computed at, see the
+//! XxxIsWide functions. Results are rounded half away from zero when the scale decreases.
+struct DecimalKernels {
+	//! The digits of a value of the width after rescaling it from "scale" to "target_scale".
+	static constexpr idx_t ScaledDigits(idx_t width, idx_t scale, idx_t target_scale) {
+		return width + (target_scale > scale ? target_scale - scale : 0);
+	}
+	static constexpr idx_t MaxScale(idx_t a_scale, idx_t b_scale) {
+		return a_scale > b_scale ? a_scale : b_scale;
+	}
+
+	//! Whether an addition or subtraction needs to be computed on hugeint_t.
+	static constexpr bool AddIsWide(idx_t a_width, idx_t a_scale, idx_t b_width, idx_t b_scale, idx_t result_width,
+	                                idx_t result_scale) {
+		return result_width > DecimalArithmetic<int64_t>::MAX_DIGITS ||
+		       ScaledDigits((ScaledDigits(a_width, a_scale, MaxScale(a_scale, b_scale)) >
+		                             ScaledDigits(b_width, b_scale, MaxScale(a_scale, b_scale))
+		                         ? ScaledDigits(a_width, a_scale, MaxScale(a_scale, b_scale))
+		                         : ScaledDigits(b_width, b_scale, MaxScale(a_scale, b_scale))) +
+		                        1,
+		                    MaxScale(a_scale, b_scale), result_scale) > DecimalArithmetic<int64_t>::MAX_DIGITS;
+	}
+
+	//! Whether a multiplication needs to be computed on hugeint_t.
+	static constexpr bool MultiplyIsWide(idx_t a_width, idx_t a_scale, idx_t b_width, idx_t b_scale, idx_t result_width,
+	                                     idx_t result_scale) {
+		return result_width > DecimalArithmetic<int64_t>::MAX_DIGITS ||
+		       ScaledDigits(a_width + b_width, a_scale + b_scale, result_scale) > DecimalArithmetic<int64_t>::MAX_DIGITS;
+	}
+
+	//! Whether a rescale needs to be computed on hugeint_t.
+	static constexpr bool RescaleIsWide(idx_t width, idx_t scale, idx_t result_width, idx_t result_scale) {
+		return result_width > DecimalArithmetic<int64_t>::MAX_DIGITS ||
+		       ScaledDigits(width, scale, result_scale) > DecimalArithmetic<int64_t>::MAX_DIGITS;
+	}
+
+	template <class INTERMEDIATE>
+	static bool TryRescale(INTERMEDIATE value, idx_t scale, idx_t result_scale, INTERMEDIATE &result) {
+		if (result_scale >= scale) {
+			return DecimalArithmetic<INTERMEDIATE>::TryScaleUp(value, result_scale - scale, result);
+		}
+		return DecimalArithmetic<INTERMEDIATE>::TryScaleDown(value, scale - result_scale, result);
+	}
+
+	//! Converts the computed value (at result_scale) to the result storage, if it has at most result_width digits.
+	template <class INTERMEDIATE, class RESULT_T>
+	static bool TryFinalize(INTERMEDIATE value, idx_t result_width, RESULT_T &result) {
+		return DecimalArithmetic<INTERMEDIATE>::InRange(value, result_width) && DecimalConvert::Try(value, result);
+	}
+
+	template <class INTERMEDIATE, class A_T, class B_T, class RESULT_T>
+	static bool TryAdd(A_T a, idx_t a_scale, B_T b, idx_t b_scale, idx_t result_width, idx_t result_scale,
+	                   RESULT_T &result) {
+		auto scale = MaxScale(a_scale, b_scale);
+		INTERMEDIATE a_val, b_val, sum;
+		return DecimalConvert::Try(a, a_val) && DecimalConvert::Try(b, b_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TryScaleUp(a_val, scale - a_scale, a_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TryScaleUp(b_val, scale - b_scale, b_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TryAdd(a_val, b_val, sum) &&
+		       TryRescale(sum, scale, result_scale, sum) && TryFinalize(sum, result_width, result);
+	}
+
+	template <class INTERMEDIATE, class A_T, class B_T, class RESULT_T>
+	static bool TrySubtract(A_T a, idx_t a_scale, B_T b, idx_t b_scale, idx_t result_width, idx_t result_scale,
+	                        RESULT_T &result) {
+		auto scale = MaxScale(a_scale, b_scale);
+		INTERMEDIATE a_val, b_val, difference;
+		return DecimalConvert::Try(a, a_val) && DecimalConvert::Try(b, b_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TryScaleUp(a_val, scale - a_scale, a_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TryScaleUp(b_val, scale - b_scale, b_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TrySubtract(a_val, b_val, difference) &&
+		       TryRescale(difference, scale, result_scale, difference) &&
+		       TryFinalize(difference, result_width, result);
+	}
+
+	//! The product has the sum of the input scales, before it is rescaled to the result scale.
+	template <class INTERMEDIATE, class A_T, class B_T, class RESULT_T>
+	static bool TryMultiply(A_T a, idx_t a_scale, B_T b, idx_t b_scale, idx_t result_width, idx_t result_scale,
+	                        RESULT_T &result) {
+		INTERMEDIATE a_val, b_val, product;
+		return DecimalConvert::Try(a, a_val) && DecimalConvert::Try(b, b_val) &&
+		       DecimalArithmetic<INTERMEDIATE>::TryMultiply(a_val, b_val, product) &&
+		       TryRescale(product, a_scale + b_scale, result_scale, product) &&
+		       TryFinalize(product, result_width, result);
+	}
+
+	template <class INTERMEDIATE, class A_T, class RESULT_T>
+	static bool TryRescale(A_T a, idx_t scale, idx_t result_width, idx_t result_scale, RESULT_T &result) {
+		INTERMEDIATE value;
+		return DecimalConvert::Try(a, value) && TryRescale(value, scale, result_scale, value) &&
+		       TryFinalize(value, result_width, result);
+	}
+
+	static Exception Overflow(const char *operation, const DecimalFormat &result) {
+		return Exception(std::string("Overflow in DECIMAL ") + operation + ", the result does not fit in " +
+		                 result.ToString());
+	}
+};
+
+template <bool WIDE>
+struct DecimalIntermediate {
+	using type = int64_t;
+};
+
+template <>
+struct DecimalIntermediate<true> {
+	using type = hugeint_t;
+};
+
+//! A DECIMAL(WIDTH, SCALE) value, passed to operators as its stored integer (int16_t, int32_t, int64_t or hugeint_t)
+//! without converting it. The value is the integer divided by 10^SCALE.
+template <uint8_t WIDTH_T, uint8_t SCALE_T>
+struct DecimalType {
+	static_assert(WIDTH_T >= 1 && WIDTH_T <= DecimalFormat::MAX_WIDTH, "DECIMAL width must be between 1 and 38");
+	static_assert(SCALE_T <= WIDTH_T, "DECIMAL scale must not exceed the width");
+
+	static constexpr uint8_t WIDTH = WIDTH_T;
+	static constexpr uint8_t SCALE = SCALE_T;
+
+	using STORAGE_TYPE = typename DecimalStorage<WIDTH_T>::type;
+	using ARG_TYPE = STORAGE_TYPE;
+	using STRUCT_STATE = PrimitiveTypeState<STORAGE_TYPE>;
+
+	static void ConstructType(STRUCT_STATE &state, idx_t r, ARG_TYPE &output) {
+		output = state.data[r];
+	}
+
+	static void SetNull(Vector &result, STRUCT_STATE &result_state, idx_t r) {
+		ValidityMask::SetInvalid(result, result_state.validity, r);
+	}
+
+	static void AssignResult(Vector &result, idx_t r, ARG_TYPE result_val) {
+		AssignResult::Assign<STORAGE_TYPE>(result, r, result_val);
+	}
+
+	static LogicalType CreateLogicalType() {
+		return LogicalType::DECIMAL(WIDTH_T, SCALE_T);
+	}
+
+	static DecimalFormat Format() {
+		return DecimalFormat(WIDTH_T, SCALE_T);
+	}
+};
+
+//! a + b as a DECIMAL of the result type, e.g. BinaryFunction<DecimalAddOperator<A, B, R>, A, B, R>. Throws when the
+//! sum does not fit. The intermediate type is picked at compile time from the widths and scales.
+template <class A_TYPE, class B_TYPE, class RESULT_TYPE>
+struct DecimalAddOperator {
+	using INTERMEDIATE = typename DecimalIntermediate<DecimalKernels::AddIsWide(
+	    A_TYPE::WIDTH, A_TYPE::SCALE, B_TYPE::WIDTH, B_TYPE::SCALE, RESULT_TYPE::WIDTH, RESULT_TYPE::SCALE)>::type;
+
+	static typename RESULT_TYPE::ARG_TYPE Operation(typename A_TYPE::ARG_TYPE a, typename B_TYPE::ARG_TYPE b) {
+		typename RESULT_TYPE::ARG_TYPE result;
+		if (!DecimalKernels::TryAdd<INTERMEDIATE>(a, A_TYPE::SCALE, b, B_TYPE::SCALE, RESULT_TYPE::WIDTH,
+		                                          RESULT_TYPE::SCALE, result)) {
+			throw DecimalKernels::Overflow("addition", RESULT_TYPE::Format());
+		}
+		return result;
+	}
+};
+
+template <class A_TYPE, class B_TYPE, class RESULT_TYPE>
+struct DecimalSubtractOperator {
+	using INTERMEDIATE = typename DecimalIntermediate<DecimalKernels::AddIsWide(
+	    A_TYPE::WIDTH, A_TYPE::SCALE, B_TYPE::WIDTH, B_TYPE::SCALE, RESULT_TYPE::WIDTH, RESULT_TYPE::SCALE)>::type;
+
+	static typename RESULT_TYPE::ARG_TYPE Operation(typename A_TYPE::ARG_TYPE a, typename B_TYPE::ARG_TYPE b) {
+		typename RESULT_TYPE::ARG_TYPE result;
+		if (!DecimalKernels::TrySubtract<INTERMEDIATE>(a, A_TYPE::SCALE, b, B_TYPE::SCALE, RESULT_TYPE::WIDTH,
+		                                               RESULT_TYPE::SCALE, result)) {
+			throw DecimalKernels::Overflow("subtraction", RESULT_TYPE::Format());
+		}
+		return result;
+	}
+};
+
+template <class A_TYPE, class B_TYPE, class RESULT_TYPE>
+struct DecimalMultiplyOperator {
+	using INTERMEDIATE = typename DecimalIntermediate<DecimalKernels::MultiplyIsWide(
+	    A_TYPE::WIDTH, A_TYPE::SCALE, B_TYPE::WIDTH, B_TYPE::SCALE, RESULT_TYPE::WIDTH, RESULT_TYPE::SCALE)>::type;
+
+	static typename RESULT_TYPE::ARG_TYPE Operation(typename A_TYPE::ARG_TYPE a, typename B_TYPE::ARG_TYPE b) {
+		typename RESULT_TYPE::ARG_TYPE result;
+		if (!DecimalKernels::TryMultiply<INTERMEDIATE>(a, A_TYPE::SCALE, b, B_TYPE::SCALE, RESULT_TYPE::WIDTH,
+		                                               RESULT_TYPE::SCALE, result)) {
+			throw DecimalKernels::Overflow("multiplication", RESULT_TYPE::Format());
+		}
+		return result;
+	}
+};
+
+//! Converts a DECIMAL to another width and scale, e.g. UnaryFunction<DecimalRescaleOperator<A, R>, A, R>.
+template <class INPUT_TYPE, class RESULT_TYPE>
+struct DecimalRescaleOperator {
+	using INTERMEDIATE = typename DecimalIntermediate<DecimalKernels::RescaleIsWide(
+	    INPUT_TYPE::WIDTH, INPUT_TYPE::SCALE, RESULT_TYPE::WIDTH, RESULT_TYPE::SCALE)>::type;
+
+	static typename RESULT_TYPE::ARG_TYPE Operation(typename INPUT_TYPE::ARG_TYPE input) {
+		typename RESULT_TYPE::ARG_TYPE result;
+		if (!DecimalKernels::TryRescale<INTERMEDIATE>(input, INPUT_TYPE::SCALE, RESULT_TYPE::WIDTH,
+		                                              RESULT_TYPE::SCALE, result)) {
+			throw DecimalKernels::Overflow("rescale", RESULT_TYPE::Format());
+		}
+		return result;
+	}
+};
+
+//! Throws unless T is how DuckDB stores DECIMALs of the format.
+template <class T>
+inline void VerifyDecimalStorage(const DecimalFormat &format) {
+	if (format.StorageType() != DecimalStorageType<T>::value) {
+		throw Exception(format.ToString() + " is not stored as the integer type of the kernel");
+	}
+}
+
+enum class DecimalBinaryOperation : uint8_t { ADD, SUBTRACT, MULTIPLY };
+
+//! A DECIMAL addition, subtraction or multiplication between formats that are only known at runtime. Everything that
+//! depends on the formats (including whether to compute on hugeint_t) is resolved once, when the kernel is created.
+template <class A_T, class B_T, class RESULT_T>
+class DecimalBinaryKernel {
+public:
+	using A_TYPE = PrimitiveType<A_T>;
+	using B_TYPE = PrimitiveType<B_T>;
+	using RESULT_TYPE = PrimitiveType<RESULT_T>;
+
+	DecimalBinaryKernel(DecimalBinaryOperation operation_p, DecimalFormat a_p, DecimalFormat b_p,
+	                    DecimalFormat result_p)
+	    : operation(operation_p), a(a_p), b(b_p), result(result_p) {
+		VerifyDecimalStorage<A_T>(a);
+		VerifyDecimalStorage<B_T>(b);
+		VerifyDecimalStorage<RESULT_T>(result);
+		wide = operation == DecimalBinaryOperation::MULTIPLY
+		           ? DecimalKernels::MultiplyIsWide(a.width, a.scale, b.width, b.scale, result.width, result.scale)
+		           : DecimalKernels::AddIsWide(a.width, a.scale, b.width, b.scale, result.width, result.scale);
+	}
+
+public:
+	RESULT_T Operation(A_T a_val, B_T b_val) const {
+		RESULT_T result_val;
+		auto success = wide ? Compute<hugeint_t>(a_val, b_val, result_val) : Compute<int64_t>(a_val, b_val, result_val);
+		if (!success) {
+			throw DecimalKernels::Overflow(OperationName(), result);
+		}
+		return result_val;
+	}
+
+	const DecimalFormat &AFormat() const {
+		return a;
+	}
+	const DecimalFormat &BFormat() const {
+		return b;
+	}
+	const DecimalFormat &ResultFormat() const {
+		return result;
+	}
+
+private:
+	template <class INTERMEDIATE>
+	bool Compute(A_T a_val, B_T b_val, RESULT_T &result_val) const {
+		switch (operation) {
+		case DecimalBinaryOperation::ADD:
+			return DecimalKernels::TryAdd<INTERMEDIATE>(a_val, a.scale, b_val, b.scale, result.width, result.scale,
+			                                            result_val);
+		case DecimalBinaryOperation::SUBTRACT:
+			return DecimalKernels::TrySubtract<INTERMEDIATE>(a_val, a.scale, b_val, b.scale, result.width,
+			                                                 result.scale, result_val);
+		default:
+			return DecimalKernels::TryMultiply<INTERMEDIATE>(a_val, a.scale, b_val, b.scale, result.width,
+			                                                 result.scale, result_val);
+		}
+	}
+
+	const char *OperationName() const {
+		switch (operation) {
+		case DecimalBinaryOperation::ADD:
+			return "addition";
+		case DecimalBinaryOperation::SUBTRACT:
+			return "subtraction";
+		default:
+			return "multiplication";
+		}
+	}
+
+private:
+	DecimalBinaryOperation operation;
+	DecimalFormat a;
+	DecimalFormat b;
+	DecimalFormat result;
+	bool wide;
+};
+
+//! A DECIMAL rescale between formats that are only known at runtime, resolved once when the kernel is created.
+template <class INPUT_T, class RESULT_T>
+class DecimalRescaleKernel {
+public:
+	using INPUT_TYPE = PrimitiveType<INPUT_T>;
+	using RESULT_TYPE = PrimitiveType<RESULT_T>;
+
+	DecimalRescaleKernel(DecimalFormat input_p, DecimalFormat result_p) : input(input_p), result(result_p) {
+		VerifyDecimalStorage<INPUT_T>(input);
+		VerifyDecimalStorage<RESULT_T>(result);
+		wide = DecimalKernels::RescaleIsWide(input.width, input.scale, result.width, result.scale);
+	}
+
+public:
+	RESULT_T Operation(INPUT_T input_val) const {
+		RESULT_T result_val;
+		auto success =
+		    wide ? DecimalKernels::TryRescale<hugeint_t>(input_val, input.scale, result.width, result.scale, result_val)
+		         : DecimalKernels::TryRescale<int64_t>(input_val, input.scale, result.width, result.scale, result_val);
+		if (!success) {
+			throw DecimalKernels::Overflow("rescale", result);
+		}
+		return result_val;
+	}
+
+	const DecimalFormat &InputFormat() const {
+		return input;
+	}
+	const DecimalFormat &ResultFormat() const {
+		return result;
+	}
+
+private:
+	DecimalFormat input;
+	DecimalFormat result;
+	bool wide;
+};
+
+//! name(DECIMAL, DECIMAL) -> DECIMAL over the formats of a DecimalBinaryKernel, which is shared by every execution.
+template <class KERNEL>
+class DecimalBinaryFunction : public ScalarFunction {
+public:
+	using A_TYPE = typename KERNEL::A_TYPE;
+	using B_TYPE = typename KERNEL::B_TYPE;
+	using RESULT_TYPE = typename KERNEL::RESULT_TYPE;
+
+	DecimalBinaryFunction(std::string name_p, std::shared_ptr<KERNEL> kernel_p)
+	    : name(std::move(name_p)), kernel(std::move(kernel_p)) {
+		if (!kernel) {
+			throw Exception("DecimalBinaryFunction requires a kernel, got an empty shared_ptr");
+		}
+	}
+
+	static void ExecuteBinary(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto a_vec = chunk.GetVector(0);
+		auto b_vec = chunk.GetVector(1);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		auto &function_kernel = *reinterpret_cast<KERNEL *>(ScalarFunctionInfo::Get(info)->function_data.get());
+		executor.ExecuteBinary<A_TYPE, B_TYPE, RESULT_TYPE>(
+		    a_vec, b_vec, output_vec, count,
+		    [&](const typename A_TYPE::ARG_TYPE &a_val, const typename B_TYPE::ARG_TYPE &b_val) {
+			    return function_kernel.Operation(a_val, b_val);
+		    });
+	}
+
+	const char *Name() const override {
+		return name.c_str();
+	}
+	LogicalType ReturnType() const override {
+		return kernel->ResultFormat().CreateType();
+	}
+	std::vector<LogicalType> Arguments() const override {
+		std::vector<LogicalType> arguments;
+		arguments.push_back(kernel->AFormat().CreateType());
+		arguments.push_back(kernel->BFormat().CreateType());
+		return arguments;
+	}
+	duckdb_scalar_function_t GetFunction() const override {
+		return ExecuteBinary;
+	}
+	std::shared_ptr<void> FunctionData() const override {
+		return kernel;
+	}
+
+private:
+	std::string name;
+	std::shared_ptr<KERNEL> kernel;
+};
+
+//! name(DECIMAL) -> DECIMAL over the formats of a DecimalRescaleKernel, which is shared by every execution.
+template <class KERNEL>
+class DecimalUnaryFunction : public ScalarFunction {
+public:
+	using INPUT_TYPE = typename KERNEL::INPUT_TYPE;
+	using RESULT_TYPE = typename KERNEL::RESULT_TYPE;
+
+	DecimalUnaryFunction(std::string name_p, std::shared_ptr<KERNEL> kernel_p)
+	    : name(std::move(name_p)), kernel(std::move(kernel_p)) {
+		if (!kernel) {
+			throw Exception("DecimalUnaryFunction requires a kernel, got an empty shared_ptr");
+		}
+	}
+
+	static void ExecuteUnary(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto input_vec = chunk.GetVector(0);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		auto &function_kernel = *reinterpret_cast<KERNEL *>(ScalarFunctionInfo::Get(info)->function_data.get());
+		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE>(
+		    input_vec, output_vec, count,
+		    [&](const typename INPUT_TYPE::ARG_TYPE &input_val) { return function_kernel.Operation(input_val); });
+	}
+
+	const char *Name() const override {
+		return name.c_str();
+	}
+	LogicalType ReturnType() const override {
+		return kernel->ResultFormat().CreateType();
+	}
+	std::vector<LogicalType> Arguments() const override {
+		std::vector<LogicalType> arguments;
+		arguments.push_back(kernel->InputFormat().CreateType());
+		return arguments;
+	}
+	duckdb_scalar_function_t GetFunction() const override {
+		return ExecuteUnary;
+	}
+	std::shared_ptr<void> FunctionData() const override {
+		return kernel;
+	}
+
+private:
+	std::string name;
+	std::shared_ptr<KERNEL> kernel;
+};
+
+} // namespace duckdb_stable
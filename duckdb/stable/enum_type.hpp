@@ -0,0 +1,371 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/enum_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/string_type.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+#include "duckdb/stable/vector.hpp"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! The values of an ENUM type, indexed by their code.
+class EnumDictionary {
+public:
+	explicit EnumDictionary(std::vector<std::string> values_p) : values(std::move(values_p)) {
+		for (idx_t code = 0; code < values.size(); code++) {
+			if (!codes.emplace(values[code], code).second) {
+				throw Exception("Duplicate value \"" + values[code] + "\" in ENUM dictionary");
+			}
+		}
+	}
+
+	//! Reads the dictionary of an ENUM type.
+	static EnumDictionary FromType(LogicalType &type) {
+		if (type.c_type() != DUCKDB_TYPE_ENUM) {
+			throw Exception("Not an ENUM type");
+		}
+		std::vector<std::string> values;
+		auto size = duckdb_enum_dictionary_size(type.c_logical_type());
+		values.reserve(size);
+		for (idx_t code = 0; code < size; code++) {
+			auto value = duckdb_enum_dictionary_value(type.c_logical_type(), code);
+			values.emplace_back(value);
+			duckdb_free(value);
+		}
+		return EnumDictionary(std::move(values));
+	}
+
+	//! The type that DuckDB stores the codes of a dictionary of this size as.
+	static duckdb_type CodeType(idx_t size) {
+		if (size <= 0xFF) {
+			return DUCKDB_TYPE_UTINYINT;
+		}
+		if (size <= 0xFFFF) {
+			return DUCKDB_TYPE_USMALLINT;
+		}
+		return DUCKDB_TYPE_UINTEGER;
+	}
+
+public:
+	idx_t Size() const {
+		return values.size();
+	}
+
+	string_t GetValue(idx_t code) const {
+		auto &value = values[code];
+		return string_t(value.c_str(), static_cast<uint32_t>(value.size()));
+	}
+
+	const std::vector<std::string> &Values() const {
+		return values;
+	}
+
+	//! Returns whether the value is in the dictionary.
+	bool TryGetCode(const std::string &value, idx_t &code) const {
+		auto entry = codes.find(value);
+		if (entry == codes.end()) {
+			return false;
+		}
+		code = entry->second;
+		return true;
+	}
+
+	duckdb_type CodeType() const {
+		return CodeType(values.size());
+	}
+
+	LogicalType CreateType() const {
+		return LogicalType::ENUM(values);
+	}
+
+private:
+	std::vector<std::string> values;
+	std::unordered_map<std::string, idx_t> codes;
+};
+
+template <class CODE_T>
+struct EnumCodeType {};
+
+template <>
+struct EnumCodeType<uint8_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_UTINYINT;
+};
+
+template <>
+struct EnumCodeType<uint16_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_USMALLINT;
+};
+
+template <>
+struct EnumCodeType<uint32_t> {
+	static constexpr duckdb_type value = DUCKDB_TYPE_UINTEGER;
+};
+
+template <class CODE_T>
+struct EnumTypeState {
+	CODE_T *data = nullptr;
+	uint64_t *validity = nullptr;
+	duckdb_vector vector = nullptr;
+	//! Only read from the type when an operator asks for it.
+	std::unique_ptr<EnumDictionary> dictionary;
+
+	void PrepareVector(Vector &input, idx_t count) {
+		data = reinterpret_cast<CODE_T *>(duckdb_vector_get_data(input.c_vector()));
+		validity = duckdb_vector_get_validity(input.c_vector());
+		vector = input.c_vector();
+		dictionary.reset();
+	}
+
+	const EnumDictionary &GetDictionary() {
+		if (!dictionary) {
+			auto type = Vector(vector).GetLogicalType();
+			dictionary.reset(new EnumDictionary(EnumDictionary::FromType(type)));
+		}
+		return *dictionary;
+	}
+};
+
+//! A value of an ENUM column: its code, and the dictionary of the column.
+template <class CODE_T>
+struct EnumValue {
+	EnumValue() : code(0), state(nullptr) {
+	}
+	explicit EnumValue(CODE_T code_p) : code(code_p), state(nullptr) {
+	}
+
+	CODE_T code;
+
+	//! Reads the whole dictionary of the vector on first use - operators that look at the values of every row are
+	//! better off as an EnumMapFunction, which evaluates them once per dictionary entry.
+	const EnumDictionary &Dictionary() const {
+		return state->GetDictionary();
+	}
+	string_t GetValue() const {
+		return Dictionary().GetValue(code);
+	}
+
+private:
+	template <class T>
+	friend struct EnumType;
+	EnumTypeState<CODE_T> *state;
+};
+
+//! An ENUM column whose codes are stored as CODE_T (uint8_t, uint16_t or uint32_t, see EnumDictionary::CodeType).
+//! Operators receive the code, so they can look up a result per code instead of comparing strings per row.
+template <class CODE_T>
+struct EnumType {
+	using ARG_TYPE = EnumValue<CODE_T>;
+	using STRUCT_STATE = EnumTypeState<CODE_T>;
+
+	static void ConstructType(STRUCT_STATE &state, idx_t r, ARG_TYPE &output) {
+		output.code = state.data[r];
+		output.state = &state;
+	}
+
+	static void SetNull(Vector &result, STRUCT_STATE &result_state, idx_t r) {
+		ValidityMask::SetInvalid(result, result_state.validity, r);
+	}
+
+	static void AssignResult(Vector &result, idx_t r, ARG_TYPE result_val) {
+		AssignResult::Assign<CODE_T>(result, r, result_val.code);
+	}
+	//! Any ENUM whose codes are stored as CODE_T.
+	static bool MatchesLogicalType(duckdb_logical_type type) {
+		return duckdb_get_type_id(type) == DUCKDB_TYPE_ENUM &&
+		       duckdb_enum_internal_type(type) == EnumCodeType<CODE_T>::value;
+	}
+};
+
+//! Throws for an empty dictionary pointer, which a function over an ENUM type cannot be created without.
+inline void VerifyEnumDictionary(const EnumDictionary *dictionary) {
+	if (!dictionary) {
+		throw Exception("An ENUM function requires a dictionary, got an empty shared_ptr");
+	}
+}
+
+//! Throws unless CODE_T is the code type of the dictionary, which the function is registered over.
+template <class CODE_T>
+inline void VerifyEnumCodeType(const EnumDictionary &dictionary) {
+	if (dictionary.CodeType() != EnumCodeType<CODE_T>::value) {
+		throw Exception("The codes of an ENUM with " + std::to_string(dictionary.Size()) +
+		                " values do not have the code type of the function");
+	}
+}
+
+//! name(ENUM) -> RESULT_TYPE over the ENUM type of a dictionary: OP::Operation(const EnumValue<CODE_T> &input,
+//! const EnumDictionary &dictionary).
+template <class OP, class CODE_T, class RETURN_TYPE_T>
+class EnumFunction : public ScalarFunction {
+public:
+	using INPUT_TYPE = EnumType<CODE_T>;
+	using RESULT_TYPE = RETURN_TYPE_T;
+
+	EnumFunction(std::string name_p, std::shared_ptr<EnumDictionary> dictionary_p)
+	    : name(std::move(name_p)), dictionary(std::move(dictionary_p)) {
+		VerifyEnumDictionary(dictionary.get());
+		VerifyEnumCodeType<CODE_T>(*dictionary);
+	}
+
+	static void ExecuteUnary(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto input_vec = chunk.GetVector(0);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		using INPUT_ARG = ExecutorArgument<INPUT_TYPE, OperatorNullHandling<OP>::value>;
+		auto &dictionary = *reinterpret_cast<EnumDictionary *>(ScalarFunctionInfo::Get(info)->function_data.get());
+		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
+		    input_vec, output_vec, count,
+		    [&](const typename INPUT_ARG::ARG_TYPE &input_val) { return OP::Operation(input_val, dictionary); });
+	}
+
+	const char *Name() const override {
+		return name.c_str();
+	}
+	LogicalType ReturnType() const override {
+		return TemplateToType::Intern<RESULT_TYPE>();
+	}
+	std::vector<LogicalType> Arguments() const override {
+		std::vector<LogicalType> arguments;
+		arguments.push_back(dictionary->CreateType());
+		return arguments;
+	}
+	duckdb_scalar_function_t GetFunction() const override {
+		return ExecuteUnary;
+	}
+	std::shared_ptr<void> FunctionData() const override {
+		return dictionary;
+	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
+
+private:
+	std::string name;
+	std::shared_ptr<EnumDictionary> dictionary;
+};
+
+//! The result of an operator for every entry of a dictionary.
+template <class T>
+struct EnumMapData {
+	std::shared_ptr<EnumDictionary> dictionary;
+	std::vector<ResultValue<T>> results;
+	//! The error the operator threw for an entry, empty if it did not.
+	std::vector<std::string> errors;
+	//! Owns the string results, so they outlive the operator call that produced them.
+	std::deque<std::string> strings;
+
+	void Persist(ResultValue<T> &) {
+	}
+};
+
+template <>
+inline void EnumMapData<string_t>::Persist(ResultValue<string_t> &result) {
+	if (!result.is_null) {
+		strings.emplace_back(result.val.GetData(), result.val.GetSize());
+		auto &copy = strings.back();
+		result.val = string_t(copy.c_str(), static_cast<uint32_t>(copy.size()));
+	}
+}
+
+//! name(ENUM) -> RESULT_TYPE that evaluates OP::Operation(const string_t &value) once per dictionary entry when the
+//! function is created. Rows then only look up the result of their code, which is O(dictionary) string work in
+//! total instead of O(rows * string length). Errors are raised for the rows whose value made the operator throw. The
+//! results are frozen, so OP must be CONSISTENT and propagate NULLs.
+template <class OP, class CODE_T, class RETURN_TYPE_T>
+class EnumMapFunction : public ScalarFunction {
+public:
+	using INPUT_TYPE = EnumType<CODE_T>;
+	using RESULT_TYPE = RETURN_TYPE_T;
+	using DATA = EnumMapData<typename RESULT_TYPE::ARG_TYPE>;
+
+	static_assert(OperatorStability<OP>::value == FunctionStability::CONSISTENT,
+	              "Only CONSISTENT operators can be evaluated once per dictionary entry");
+	static_assert(OperatorNullHandling<OP>::value == FunctionNullHandling::DEFAULT_NULL_HANDLING,
+	              "Operators that handle NULLs themselves cannot be evaluated once per dictionary entry");
+
+	EnumMapFunction(std::string name_p, std::shared_ptr<EnumDictionary> dictionary)
+	    : name(std::move(name_p)), data(std::make_shared<DATA>()) {
+		VerifyEnumDictionary(dictionary.get());
+		VerifyEnumCodeType<CODE_T>(*dictionary);
+		data->results.resize(dictionary->Size());
+		data->errors.resize(dictionary->Size());
+		for (idx_t code = 0; code < dictionary->Size(); code++) {
+			try {
+				data->results[code] = OP::Operation(dictionary->GetValue(code));
+				data->Persist(data->results[code]);
+			} catch (std::exception &ex) {
+				data->errors[code] = ex.what();
+			}
+		}
+		data->dictionary = std::move(dictionary);
+	}
+
+	static void ExecuteUnary(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto input_vec = chunk.GetVector(0);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		auto &map = *reinterpret_cast<DATA *>(ScalarFunctionInfo::Get(info)->function_data.get());
+		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE>(input_vec, output_vec, count,
+		                                               [&](const EnumValue<CODE_T> &input_val) {
+			                                               auto &error = map.errors[input_val.code];
+			                                               if (!error.empty()) {
+				                                               throw Exception(error);
+			                                               }
+			                                               return map.results[input_val.code];
+		                                               });
+	}
+
+	const char *Name() const override {
+		return name.c_str();
+	}
+	LogicalType ReturnType() const override {
+		return TemplateToType::Intern<RESULT_TYPE>();
+	}
+	std::vector<LogicalType> Arguments() const override {
+		std::vector<LogicalType> arguments;
+		arguments.push_back(data->dictionary->CreateType());
+		return arguments;
+	}
+	duckdb_scalar_function_t GetFunction() const override {
+		return ExecuteUnary;
+	}
+	std::shared_ptr<void> FunctionData() const override {
+		return data;
+	}
+
+private:
+	std::string name;
+	std::shared_ptr<DATA> data;
+};
+
+} // namespace duckdb_stable
@@ -8,9 +8,13 @@
 
 #pragma once
 
+#include "duckdb/stable/allocator.hpp"
 #include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+#include <algorithm>
 #include <functional>
 #include <cstddef>
+#include <vector>
 
 namespace duckdb_stable {
 
@@ -28,41 +32,143 @@ struct ResultValue {
 	bool is_null = false;
 };
 
+//! Whether a function returns the same result for the same input. DuckDB can constant-fold CONSISTENT functions.
+enum class FunctionStability : uint8_t { CONSISTENT, CONSISTENT_WITHIN_QUERY, VOLATILE };
+
+//! With DEFAULT_NULL_HANDLING a NULL in any input produces a NULL without invoking the operator. With
+//! SPECIAL_HANDLING the operator receives every input wrapped in a ResultValue and decides itself.
+enum class FunctionNullHandling : uint8_t { DEFAULT_NULL_HANDLING, SPECIAL_HANDLING };
+
+//! Operators can declare "static constexpr FunctionStability STABILITY" - they are CONSISTENT otherwise.
+template <class OP, class = void>
+struct OperatorStability {
+	static constexpr FunctionStability value = FunctionStability::CONSISTENT;
+};
+
+template <class OP>
+struct OperatorStability<OP, decltype(void(OP::STABILITY))> {
+	static constexpr FunctionStability value = OP::STABILITY;
+};
+
+//! Operators can declare "static constexpr FunctionNullHandling NULL_HANDLING" - they propagate NULLs otherwise.
+template <class OP, class = void>
+struct OperatorNullHandling {
+	static constexpr FunctionNullHandling value = FunctionNullHandling::DEFAULT_NULL_HANDLING;
+};
+
+template <class OP>
+struct OperatorNullHandling<OP, decltype(void(OP::NULL_HANDLING))> {
+	static constexpr FunctionNullHandling value = OP::NULL_HANDLING;
+};
+
+//! The argument that is passed to an operator for an input of type TYPE.
+template <class TYPE, FunctionNullHandling NULL_HANDLING>
+struct ExecutorArgument {
+	using ARG_TYPE = typename TYPE::ARG_TYPE;
+
+	static void Construct(typename TYPE::STRUCT_STATE &state, idx_t r, bool, ARG_TYPE &output) {
+		TYPE::ConstructType(state, r, output);
+	}
+};
+
+template <class TYPE>
+struct ExecutorArgument<TYPE, FunctionNullHandling::SPECIAL_HANDLING> {
+	using ARG_TYPE = ResultValue<typename TYPE::ARG_TYPE>;
+
+	static void Construct(typename TYPE::STRUCT_STATE &state, idx_t r, bool is_valid, ARG_TYPE &output) {
+		output.is_null = !is_valid;
+		if (is_valid) {
+			TYPE::ConstructType(state, r, output.val);
+		}
+	}
+};
+
+//! The arguments of a single row of a variadic function, in argument order.
+template <class T>
+class VarargsRow {
+public:
+	VarargsRow(const T *data_p, idx_t size_p) : data(data_p), count(size_p) {
+	}
+
+public:
+	idx_t size() const { // NOLINT: match the standard container naming.
+		return count;
+	}
+	const T &operator[](idx_t i) const {
+		return data[i];
+	}
+	const T *begin() const { // NOLINT: match the standard container naming.
+		return data;
+	}
+	const T *end() const { // NOLINT: match the standard container naming.
+		return data + count;
+	}
+
+private:
+	const T *data;
+	idx_t count;
+};
+
 class Executor {
 public:
-	template <class A_TYPE, class RESULT_TYPE, class FUNC>
+	template <class A_TYPE, class RESULT_TYPE,
+	          FunctionNullHandling NULL_HANDLING = FunctionNullHandling::DEFAULT_NULL_HANDLING, class FUNC>
 	void ExecuteUnary(Vector &input, Vector &result, idx_t count, FUNC fun) {
+		using A_ARG = ExecutorArgument<A_TYPE, NULL_HANDLING>;
+
 		typename A_TYPE::STRUCT_STATE a_state;
 		a_state.PrepareVector(input, count);
 
 		typename RESULT_TYPE::STRUCT_STATE result_state;
-		for (idx_t r = 0; r < count; r++) {
-			if (!duckdb_validity_row_is_valid(a_state.validity, r)) {
-				RESULT_TYPE::SetNull(result, result_state, r);
-				continue;
-			}
-			typename A_TYPE::ARG_TYPE a_val;
-			A_TYPE::ConstructType(a_state, r, a_val);
+		auto execute_row = [&](idx_t r, bool a_valid) -> bool {
+			typename A_ARG::ARG_TYPE a_val;
+			A_ARG::Construct(a_state, r, a_valid, a_val);
 
 			ResultValue<typename RESULT_TYPE::ARG_TYPE> result_value;
 			try {
 				result_value = fun(a_val);
 			} catch (std::exception &ex) {
-				if (!SetError(ex.what(), r, result)) {
-					return;
-				}
-				continue;
+				return SetError(ex.what(), r, result);
 			}
 			if (result_value.is_null) {
 				RESULT_TYPE::SetNull(result, result_state, r);
+			} else {
+				RESULT_TYPE::AssignResult(result, r, result_value.val);
+			}
+			return true;
+		};
+
+		ValidityMask a_mask(a_state.validity);
+		for (idx_t base = 0; base < count; base += ValidityMask::BITS_PER_WORD) {
+			auto end = std::min<idx_t>(base + ValidityMask::BITS_PER_WORD, count);
+			auto a_word = a_mask.GetWord(base / ValidityMask::BITS_PER_WORD);
+			if (a_word == ValidityMask::ALL_VALID) {
+				for (idx_t r = base; r < end; r++) {
+					if (!execute_row(r, true)) {
+						return;
+					}
+				}
 				continue;
 			}
-			RESULT_TYPE::AssignResult(result, r, result_value.val);
+			for (idx_t r = base; r < end; r++) {
+				auto a_valid = ValidityMask::RowIsValid(a_word, r - base);
+				if (NULL_HANDLING == FunctionNullHandling::DEFAULT_NULL_HANDLING && !a_valid) {
+					RESULT_TYPE::SetNull(result, result_state, r);
+					continue;
+				}
+				if (!execute_row(r, a_valid)) {
+					return;
+				}
+			}
 		}
 	}
 
-	template <class A_TYPE, class B_TYPE, class RESULT_TYPE, class FUNC>
+	template <class A_TYPE, class B_TYPE, class RESULT_TYPE,
+	          FunctionNullHandling NULL_HANDLING = FunctionNullHandling::DEFAULT_NULL_HANDLING, class FUNC>
 	void ExecuteBinary(Vector &a, Vector &b, Vector &result, idx_t count, FUNC fun) {
+		using A_ARG = ExecutorArgument<A_TYPE, NULL_HANDLING>;
+		using B_ARG = ExecutorArgument<B_TYPE, NULL_HANDLING>;
+
 		typename A_TYPE::STRUCT_STATE a_state;
 		typename B_TYPE::STRUCT_STATE b_state;
 
@@ -70,31 +176,105 @@ public:
 		b_state.PrepareVector(b, count);
 
 		typename RESULT_TYPE::STRUCT_STATE result_state;
-		for (idx_t r = 0; r < count; r++) {
-			if (!duckdb_validity_row_is_valid(a_state.validity, r) ||
-			    !duckdb_validity_row_is_valid(b_state.validity, r)) {
-				RESULT_TYPE::SetNull(result, result_state, r);
-				continue;
-			}
-			typename A_TYPE::ARG_TYPE a_val;
-			typename B_TYPE::ARG_TYPE b_val;
-			A_TYPE::ConstructType(a_state, r, a_val);
-			B_TYPE::ConstructType(b_state, r, b_val);
+		auto execute_row = [&](idx_t r, bool a_valid, bool b_valid) -> bool {
+			typename A_ARG::ARG_TYPE a_val;
+			typename B_ARG::ARG_TYPE b_val;
+			A_ARG::Construct(a_state, r, a_valid, a_val);
+			B_ARG::Construct(b_state, r, b_valid, b_val);
 
 			ResultValue<typename RESULT_TYPE::ARG_TYPE> result_value;
 			try {
 				result_value = fun(a_val, b_val);
 			} catch (std::exception &ex) {
-				if (!SetError(ex.what(), r, result)) {
-					return;
-				}
-				continue;
+				return SetError(ex.what(), r, result);
 			}
 			if (result_value.is_null) {
 				RESULT_TYPE::SetNull(result, result_state, r);
+			} else {
+				RESULT_TYPE::AssignResult(result, r, result_value.val);
+			}
+			return true;
+		};
+
+		ValidityMask a_mask(a_state.validity);
+		ValidityMask b_mask(b_state.validity);
+		for (idx_t base = 0; base < count; base += ValidityMask::BITS_PER_WORD) {
+			auto end = std::min<idx_t>(base + ValidityMask::BITS_PER_WORD, count);
+			auto a_word = a_mask.GetWord(base / ValidityMask::BITS_PER_WORD);
+			auto b_word = b_mask.GetWord(base / ValidityMask::BITS_PER_WORD);
+			if ((a_word & b_word) == ValidityMask::ALL_VALID) {
+				for (idx_t r = base; r < end; r++) {
+					if (!execute_row(r, true, true)) {
+						return;
+					}
+				}
 				continue;
 			}
-			RESULT_TYPE::AssignResult(result, r, result_value.val);
+			for (idx_t r = base; r < end; r++) {
+				auto a_valid = ValidityMask::RowIsValid(a_word, r - base);
+				auto b_valid = ValidityMask::RowIsValid(b_word, r - base);
+				if (NULL_HANDLING == FunctionNullHandling::DEFAULT_NULL_HANDLING && (!a_valid || !b_valid)) {
+					RESULT_TYPE::SetNull(result, result_state, r);
+					continue;
+				}
+				if (!execute_row(r, a_valid, b_valid)) {
+					return;
+				}
+			}
+		}
+	}
+
+	//! Execute a function over every column of the input. The states of all columns are prepared once per chunk and
+	//! (with default NULL handling) their validity is combined 64 rows at a time.
+	template <class A_TYPE, class RESULT_TYPE,
+	          FunctionNullHandling NULL_HANDLING = FunctionNullHandling::DEFAULT_NULL_HANDLING, class FUNC>
+	void ExecuteVarargs(DataChunk &input, Vector &result, idx_t count, FUNC fun) {
+		using A_ARG = ExecutorArgument<A_TYPE, NULL_HANDLING>;
+
+		auto column_count = input.ColumnCount();
+		PoolVector<typename A_TYPE::STRUCT_STATE> states(column_count);
+		for (idx_t c = 0; c < column_count; c++) {
+			auto vector = input.GetVector(c);
+			states[c].PrepareVector(vector, count);
+		}
+
+		PoolVector<typename A_ARG::ARG_TYPE> arguments(column_count);
+		typename RESULT_TYPE::STRUCT_STATE result_state;
+		for (idx_t base = 0; base < count; base += ValidityMask::BITS_PER_WORD) {
+			auto end = std::min<idx_t>(base + ValidityMask::BITS_PER_WORD, count);
+			auto w = base / ValidityMask::BITS_PER_WORD;
+			uint64_t row_word = ValidityMask::ALL_VALID;
+			if (NULL_HANDLING == FunctionNullHandling::DEFAULT_NULL_HANDLING) {
+				for (auto &state : states) {
+					row_word &= ValidityMask(state.validity).GetWord(w);
+				}
+			}
+			for (idx_t r = base; r < end; r++) {
+				if (!ValidityMask::RowIsValid(row_word, r - base)) {
+					RESULT_TYPE::SetNull(result, result_state, r);
+					continue;
+				}
+				for (idx_t c = 0; c < column_count; c++) {
+					auto is_valid = NULL_HANDLING == FunctionNullHandling::DEFAULT_NULL_HANDLING ||
+					                ValidityMask(states[c].validity).RowIsValid(r);
+					A_ARG::Construct(states[c], r, is_valid, arguments[c]);
+				}
+
+				ResultValue<typename RESULT_TYPE::ARG_TYPE> result_value;
+				try {
+					result_value = fun(VarargsRow<typename A_ARG::ARG_TYPE>(arguments.data(), column_count));
+				} catch (std::exception &ex) {
+					if (!SetError(ex.what(), r, result)) {
+						return;
+					}
+					continue;
+				}
+				if (result_value.is_null) {
+					RESULT_TYPE::SetNull(result, result_state, r);
+					continue;
+				}
+				RESULT_TYPE::AssignResult(result, r, result_value.val);
+			}
 		}
 	}
 
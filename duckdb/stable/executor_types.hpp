@@ -12,8 +12,12 @@
 #include "duckdb/stable/data_chunk.hpp"
 #include "duckdb/stable/hugeint.hpp"
 #include "duckdb/stable/string_type.hpp"
+#include "duckdb/stable/uhugeint.hpp"
+#include "duckdb/stable/validity_mask.hpp"
 #include "duckdb/stable/vector.hpp"
 
+#include <type_traits>
+
 namespace duckdb_stable {
 
 template <class INPUT_TYPE>
@@ -56,11 +60,7 @@ struct PrimitiveType {
 	}
 
 	static void SetNull(Vector &result, STRUCT_STATE &result_state, idx_t i) {
-		if (!result_state.validity) {
-			duckdb_vector_ensure_validity_writable(result.c_vector());
-			result_state.validity = duckdb_vector_get_validity(result.c_vector());
-		}
-		duckdb_validity_set_row_invalid(result_state.validity, i);
+		ValidityMask::SetInvalid(result, result_state.validity, i);
 	}
 
 	static void AssignResult(Vector &result, idx_t r, ARG_TYPE result_val) {
@@ -89,6 +89,9 @@ struct StructTypeStateTernary {
 	}
 };
 
+template <class T, class = void>
+struct TypeMatchesLogicalType;
+
 template <class A_TYPE, class B_TYPE, class C_TYPE>
 struct StructTypeTernary {
 	typename A_TYPE::ARG_TYPE a_val;
@@ -105,11 +108,7 @@ struct StructTypeTernary {
 	}
 
 	static void SetNull(Vector &result, STRUCT_STATE &result_state, idx_t r) {
-		if (!result_state.validity) {
-			duckdb_vector_ensure_validity_writable(result.c_vector());
-			result_state.validity = duckdb_vector_get_validity(result.c_vector());
-		}
-		duckdb_validity_set_row_invalid(result_state.validity, r);
+		ValidityMask::SetInvalid(result, result_state.validity, r);
 
 		auto a_child = result.GetChild(0);
 		auto b_child = result.GetChild(1);
@@ -129,6 +128,18 @@ struct StructTypeTernary {
 		auto c_child = result.GetChild(2);
 		C_TYPE::AssignResult(c_child, r, result_val.c_val);
 	}
+	//! A STRUCT with three fields of the child types, whatever their names.
+	static bool MatchesLogicalType(duckdb_logical_type type) {
+		if (duckdb_get_type_id(type) != DUCKDB_TYPE_STRUCT || duckdb_struct_type_child_count(type) != 3) {
+			return false;
+		}
+		LogicalType a_type(duckdb_struct_type_child_type(type, 0));
+		LogicalType b_type(duckdb_struct_type_child_type(type, 1));
+		LogicalType c_type(duckdb_struct_type_child_type(type, 2));
+		return TypeMatchesLogicalType<A_TYPE>::Matches(a_type.c_logical_type()) &&
+		       TypeMatchesLogicalType<B_TYPE>::Matches(b_type.c_logical_type()) &&
+		       TypeMatchesLogicalType<C_TYPE>::Matches(c_type.c_logical_type());
+	}
 };
 
 template<class T>
@@ -136,9 +147,39 @@ struct AlwaysFalse {
 	static constexpr bool value = false;
 };
 
+//! Executor types whose logical type depends on their template arguments (e.g. DecimalType) provide
+//! "static LogicalType CreateLogicalType()".
+template <class T, class = void>
+struct TypeCreatesLogicalType {
+	static constexpr bool value = false;
+};
+
+template <class T>
+struct TypeCreatesLogicalType<T, decltype(void(&T::CreateLogicalType))> {
+	static constexpr bool value = true;
+};
+
 struct TemplateToType {
 	template<class T>
 	static LogicalType Convert() {
+		return ConvertDefault<T>(std::integral_constant<bool, TypeCreatesLogicalType<T>::value>());
+	}
+
+	//! A non-owning reference to a type that is created once per process. DuckDB copies the types of functions when
+	//! they are created, so every function over T can share the same handle - it must not be modified.
+	template<class T>
+	static LogicalType Intern() {
+		static LogicalType type(Convert<T>());
+		return LogicalType(type.c_logical_type(), false);
+	}
+
+private:
+	template<class T>
+	static LogicalType ConvertDefault(std::true_type) {
+		return T::CreateLogicalType();
+	}
+	template<class T>
+	static LogicalType ConvertDefault(std::false_type) {
 		static_assert(AlwaysFalse<T>::value, "Missing Type in TemplateToType");
 		throw std::runtime_error("Missing Type in TemplateType");
 	}
@@ -159,14 +200,121 @@ inline LogicalType TemplateToType::Convert<PrimitiveType<string_t>>() {
 	return LogicalType::VARCHAR();
 }
 
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<int8_t>>() {
+	return LogicalType::TINYINT();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<int16_t>>() {
+	return LogicalType::SMALLINT();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<int32_t>>() {
+	return LogicalType::INTEGER();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<int64_t>>() {
+	return LogicalType::BIGINT();
+}
+
 template <>
 inline LogicalType TemplateToType::Convert<PrimitiveType<uint8_t>>() {
 	return LogicalType::UTINYINT();
 }
 
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<uint16_t>>() {
+	return LogicalType::USMALLINT();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<uint32_t>>() {
+	return LogicalType::UINTEGER();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<uint64_t>>() {
+	return LogicalType::UBIGINT();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<float>>() {
+	return LogicalType::FLOAT();
+}
+
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<double>>() {
+	return LogicalType::DOUBLE();
+}
+
 template <>
 inline LogicalType TemplateToType::Convert<PrimitiveType<hugeint_t>>() {
 	return LogicalType::HUGEINT();
 }
 
+template <>
+inline LogicalType TemplateToType::Convert<PrimitiveType<uhugeint_t>>() {
+	return LogicalType::UHUGEINT();
+}
+
+//! The type values of the logical type are stored as in a vector: VARCHAR, BLOB and BIT are all string_t, DATE is an
+//! int32_t, the TIME and TIMESTAMP types are int64_t, and DECIMAL and ENUM values are their internal integer type.
+inline duckdb_type PhysicalTypeId(duckdb_logical_type type) {
+	auto id = duckdb_get_type_id(type);
+	switch (id) {
+	case DUCKDB_TYPE_DATE:
+		return DUCKDB_TYPE_INTEGER;
+	case DUCKDB_TYPE_TIME:
+	case DUCKDB_TYPE_TIMESTAMP:
+	case DUCKDB_TYPE_TIMESTAMP_S:
+	case DUCKDB_TYPE_TIMESTAMP_MS:
+	case DUCKDB_TYPE_TIMESTAMP_NS:
+	case DUCKDB_TYPE_TIMESTAMP_TZ:
+		return DUCKDB_TYPE_BIGINT;
+	case DUCKDB_TYPE_TIME_TZ:
+		return DUCKDB_TYPE_UBIGINT;
+	case DUCKDB_TYPE_UUID:
+		return DUCKDB_TYPE_HUGEINT;
+	case DUCKDB_TYPE_BLOB:
+	case DUCKDB_TYPE_BIT:
+	case DUCKDB_TYPE_VARINT:
+		return DUCKDB_TYPE_VARCHAR;
+	case DUCKDB_TYPE_DECIMAL:
+		return duckdb_decimal_internal_type(type);
+	case DUCKDB_TYPE_ENUM:
+		return duckdb_enum_internal_type(type);
+	default:
+		return id;
+	}
+}
+
+//! Whether vectors of the logical type can hold the values of executor type T. By default that is the case when the
+//! type is stored like the TemplateToType type of T (e.g. PrimitiveType<int64_t> matches BIGINT and TIMESTAMP), with
+//! the same scale for DECIMAL. Executor types without a single logical type (e.g. EnumType) provide
+//! "static bool MatchesLogicalType(duckdb_logical_type type)".
+template <class T, class>
+struct TypeMatchesLogicalType {
+	static bool Matches(duckdb_logical_type type) {
+		auto expected = TemplateToType::Intern<T>();
+		if (PhysicalTypeId(expected.c_logical_type()) != PhysicalTypeId(type)) {
+			return false;
+		}
+		if (duckdb_get_type_id(expected.c_logical_type()) == DUCKDB_TYPE_DECIMAL &&
+		    duckdb_get_type_id(type) == DUCKDB_TYPE_DECIMAL) {
+			return duckdb_decimal_scale(expected.c_logical_type()) == duckdb_decimal_scale(type);
+		}
+		return true;
+	}
+};
+
+template <class T>
+struct TypeMatchesLogicalType<T, decltype(void(&T::MatchesLogicalType))> {
+	static bool Matches(duckdb_logical_type type) {
+		return T::MatchesLogicalType(type);
+	}
+};
+
 } // namespace duckdb_stable
@@ -12,8 +12,12 @@
 #include "duckdb/stable/common.hpp"
 #include "duckdb/stable/exception.hpp"
 #include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/registration_builder.hpp"
+#include "duckdb/stable/replacement_scan.hpp"
 #include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/table_function.hpp"
 
+#include <memory>
 #include <string>
 
 namespace duckdb_stable {
@@ -47,17 +51,8 @@ protected:
 	}
 
 	void Register(CastFunction &cast) {
-		auto cast_function = duckdb_create_cast_function();
-		auto source_type = cast.SourceType();
-		auto target_type = cast.TargetType();
-		duckdb_cast_function_set_implicit_cast_cost(cast_function, cast.ImplicitCastCost());
-		duckdb_cast_function_set_source_type(cast_function, source_type.c_logical_type());
-		duckdb_cast_function_set_target_type(cast_function, target_type.c_logical_type());
-		duckdb_cast_function_set_function(cast_function, cast.GetFunction());
-
-		auto success = duckdb_register_cast_function(connection, cast_function) == DuckDBSuccess;
-
-		duckdb_destroy_cast_function(&cast_function);
+		auto cast_function = cast.CreateFunction();
+		auto success = duckdb_register_cast_function(connection, cast_function.c_cast_function()) == DuckDBSuccess;
 		if (!success) {
 			throw Exception("Failed to register cast function");
 		}
@@ -78,6 +73,28 @@ protected:
 		}
 	}
 
+	//! Register everything in the builder in one pass - returns the time spent per phase.
+	const RegistrationStatistics &Register(RegistrationBuilder &builder) {
+		return builder.Register(connection);
+	}
+
+	void Register(TableFunction &function) {
+		auto table_function = function.CreateFunction();
+		auto success = duckdb_register_table_function(connection, table_function.c_table_function()) == DuckDBSuccess;
+		if (!success) {
+			throw Exception(std::string("Failed to register table function ") + function.Name());
+		}
+	}
+
+	//! Replacement scans are registered on the database, which takes ownership of them.
+	void Register(std::unique_ptr<ReplacementScan> scan) {
+		auto database = access->get_database(info);
+		if (!database) {
+			throw Exception("Failed to register replacement scan: could not get the database");
+		}
+		duckdb_add_replacement_scan(*database, ReplacementScan::Callback, scan.release(), ReplacementScan::Destroy);
+	}
+
 protected:
 	duckdb_connection connection;
 	duckdb_extension_info info;
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/function_overloads.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/hugeint.hpp"
+#include "duckdb/stable/registration_builder.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/uhugeint.hpp"
+
+namespace duckdb_stable {
+
+template <class... TYPES>
+struct TypeList {};
+
+using SignedIntegerTypes = TypeList<int8_t, int16_t, int32_t, int64_t, hugeint_t>;
+using UnsignedIntegerTypes = TypeList<uint8_t, uint16_t, uint32_t, uint64_t, uhugeint_t>;
+using IntegerTypes =
+    TypeList<int8_t, int16_t, int32_t, int64_t, hugeint_t, uint8_t, uint16_t, uint32_t, uint64_t, uhugeint_t>;
+using FloatingPointTypes = TypeList<float, double>;
+using NumericTypes = TypeList<int8_t, int16_t, int32_t, int64_t, hugeint_t, uint8_t, uint16_t, uint32_t, uint64_t,
+                              uhugeint_t, float, double>;
+
+//! The result type of an overload over T: T itself unless a fixed RESULT_T is given (e.g. bool for predicates).
+template <class T, class RESULT_T>
+struct OverloadResult {
+	using type = RESULT_T;
+};
+
+template <class T>
+struct OverloadResult<T, void> {
+	using type = T;
+};
+
+//! Expands a generic OP - "template <class T> static RESULT Operation(T input)" - into one UnaryFunction per type in
+//! TYPES. Every overload is its own instantiation, so the executor loop of each type is specialized at compile time.
+template <class OP, class TYPES, class RESULT_T = void>
+struct UnaryOverloads;
+
+template <class OP, class RESULT_T, class... TYPES>
+struct UnaryOverloads<OP, TypeList<TYPES...>, RESULT_T> {
+	template <class T>
+	using FUNCTION = UnaryFunction<OP, PrimitiveType<T>, PrimitiveType<typename OverloadResult<T, RESULT_T>::type>>;
+
+	static void AddTo(ScalarFunctionSet &set) {
+		int expand[] = {0, (AddFunction<TYPES>(set), 0)...};
+		(void)expand;
+	}
+
+	static void AddTo(RegistrationBuilder &builder, const char *name) {
+		int expand[] = {0, (builder.AddFunction<FUNCTION<TYPES>>(name), 0)...};
+		(void)expand;
+	}
+
+private:
+	template <class T>
+	static void AddFunction(ScalarFunctionSet &set) {
+		FUNCTION<T> function;
+		set.AddFunction(function);
+	}
+};
+
+//! Expands a generic OP - "template <class T> static RESULT Operation(T a, T b)" - into one BinaryFunction per type.
+template <class OP, class TYPES, class RESULT_T = void>
+struct BinaryOverloads;
+
+template <class OP, class RESULT_T, class... TYPES>
+struct BinaryOverloads<OP, TypeList<TYPES...>, RESULT_T> {
+	template <class T>
+	using FUNCTION = BinaryFunction<OP, PrimitiveType<T>, PrimitiveType<T>,
+	                                PrimitiveType<typename OverloadResult<T, RESULT_T>::type>>;
+
+	static void AddTo(ScalarFunctionSet &set) {
+		int expand[] = {0, (AddFunction<TYPES>(set), 0)...};
+		(void)expand;
+	}
+
+	static void AddTo(RegistrationBuilder &builder, const char *name) {
+		int expand[] = {0, (builder.AddFunction<FUNCTION<TYPES>>(name), 0)...};
+		(void)expand;
+	}
+
+private:
+	template <class T>
+	static void AddFunction(ScalarFunctionSet &set) {
+		FUNCTION<T> function;
+		set.AddFunction(function);
+	}
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,265 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/function_profiler.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/scalar_function_info.hpp"
+#include "duckdb/stable/table_function.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+#include "duckdb/stable/vector.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! Scalar functions are only instrumented when DUCKDB_STABLE_PROFILING is defined - otherwise the profiling hooks
+//! compile to nothing.
+#ifdef DUCKDB_STABLE_PROFILING
+#define DUCKDB_STABLE_PROFILE_FUNCTION(INFO, EXECUTOR, RESULT, COUNT)                                                  \
+	duckdb_stable::FunctionProfileScope function_profile_scope(INFO, EXECUTOR, RESULT, COUNT)
+#else
+#define DUCKDB_STABLE_PROFILE_FUNCTION(INFO, EXECUTOR, RESULT, COUNT)
+#endif
+
+namespace duckdb_stable {
+
+struct FunctionProfileSnapshot {
+	std::string name;
+	uint64_t rows = 0;
+	uint64_t chunks = 0;
+	uint64_t null_rows = 0;
+	uint64_t errors = 0;
+	uint64_t nanoseconds = 0;
+};
+
+//! The counters of a single thread. They are only written by their owning thread, readers load them without locking.
+struct FunctionProfileCounters {
+	std::atomic<uint64_t> rows {0};
+	std::atomic<uint64_t> chunks {0};
+	std::atomic<uint64_t> null_rows {0};
+	std::atomic<uint64_t> errors {0};
+	std::atomic<uint64_t> nanoseconds {0};
+	FunctionProfileCounters *next = nullptr;
+
+	static void Add(std::atomic<uint64_t> &counter, uint64_t value) {
+		// Single writer: a plain load/store avoids the cost of an atomic read-modify-write.
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+};
+
+class FunctionProfile {
+public:
+	explicit FunctionProfile(std::string name_p) : name(std::move(name_p)), counters(nullptr), next(nullptr) {
+	}
+
+public:
+	const std::string &Name() const {
+		return name;
+	}
+
+	void Record(idx_t rows, idx_t null_rows, bool error, uint64_t nanoseconds) {
+		auto &thread_counters = ThreadCounters();
+		FunctionProfileCounters::Add(thread_counters.rows, rows);
+		FunctionProfileCounters::Add(thread_counters.chunks, 1);
+		FunctionProfileCounters::Add(thread_counters.null_rows, null_rows);
+		FunctionProfileCounters::Add(thread_counters.errors, error ? 1 : 0);
+		FunctionProfileCounters::Add(thread_counters.nanoseconds, nanoseconds);
+	}
+
+	//! Merge the counters of all threads.
+	FunctionProfileSnapshot Snapshot() const {
+		FunctionProfileSnapshot result;
+		result.name = name;
+		for (auto entry = counters.load(std::memory_order_acquire); entry; entry = entry->next) {
+			result.rows += entry->rows.load(std::memory_order_relaxed);
+			result.chunks += entry->chunks.load(std::memory_order_relaxed);
+			result.null_rows += entry->null_rows.load(std::memory_order_relaxed);
+			result.errors += entry->errors.load(std::memory_order_relaxed);
+			result.nanoseconds += entry->nanoseconds.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+private:
+	friend class FunctionProfiler;
+
+	FunctionProfileCounters &ThreadCounters() {
+		static thread_local std::unordered_map<const FunctionProfile *, FunctionProfileCounters *> thread_counters;
+		auto entry = thread_counters.find(this);
+		if (entry != thread_counters.end()) {
+			return *entry->second;
+		}
+		// First chunk of this function on this thread: publish a new set of counters.
+		auto result = new FunctionProfileCounters();
+		result->next = counters.load(std::memory_order_relaxed);
+		while (!counters.compare_exchange_weak(result->next, result, std::memory_order_release,
+		                                       std::memory_order_relaxed)) {
+		}
+		thread_counters[this] = result;
+		return *result;
+	}
+
+private:
+	std::string name;
+	std::atomic<FunctionProfileCounters *> counters;
+	FunctionProfile *next;
+};
+
+//! The process-wide set of function profiles. Profiles (and their counters) are never freed, as DuckDB can execute a
+//! function for as long as the database it was registered in is open.
+class FunctionProfiler {
+public:
+	static FunctionProfiler &Get() {
+		static FunctionProfiler profiler;
+		return profiler;
+	}
+
+public:
+	//! Get the profile for a function name - overloads of a function share their profile.
+	FunctionProfile &Register(const char *name) {
+		auto head = profiles.load(std::memory_order_acquire);
+		auto existing = Find(head, nullptr, name);
+		if (existing) {
+			return *existing;
+		}
+		std::unique_ptr<FunctionProfile> result(new FunctionProfile(name));
+		result->next = head;
+		while (!profiles.compare_exchange_weak(result->next, result.get(), std::memory_order_release,
+		                                       std::memory_order_acquire)) {
+			// Another thread inserted first - it may have registered the same name, which must not be added twice.
+			existing = Find(result->next, head, name);
+			if (existing) {
+				return *existing;
+			}
+			head = result->next;
+		}
+		return *result.release();
+	}
+
+	std::vector<FunctionProfileSnapshot> Snapshot() const {
+		std::vector<FunctionProfileSnapshot> result;
+		for (auto entry = profiles.load(std::memory_order_acquire); entry; entry = entry->next) {
+			result.push_back(entry->Snapshot());
+		}
+		return result;
+	}
+
+private:
+	FunctionProfiler() : profiles(nullptr) {
+	}
+
+	//! Searches the profiles from "from" up to (excluding) "until".
+	static FunctionProfile *Find(FunctionProfile *from, FunctionProfile *until, const char *name) {
+		for (auto entry = from; entry != until; entry = entry->next) {
+			if (entry->name == name) {
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+	std::atomic<FunctionProfile *> profiles;
+};
+
+//! Records a single chunk of a scalar function on destruction. The NULL count is taken from the result validity
+//! afterwards, so the executor loops themselves are not instrumented.
+class FunctionProfileScope {
+public:
+	FunctionProfileScope(duckdb_function_info info, Executor &executor_p, Vector &result_p, idx_t count_p)
+	    : profile(nullptr), executor(executor_p), result(result_p), count(count_p),
+	      start(std::chrono::steady_clock::now()) {
+		auto function_info = ScalarFunctionInfo::Get(info);
+		if (function_info) {
+			profile = function_info->profile;
+		}
+	}
+	~FunctionProfileScope() {
+		if (!profile) {
+			return;
+		}
+		auto end = std::chrono::steady_clock::now();
+		auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		profile->Record(count, CountNulls(), !executor.Success(), static_cast<uint64_t>(nanoseconds));
+	}
+
+	//! Disable copy constructors.
+	FunctionProfileScope(const FunctionProfileScope &other) = delete;
+	FunctionProfileScope &operator=(const FunctionProfileScope &) = delete;
+
+private:
+	idx_t CountNulls() {
+		ValidityMask mask(duckdb_vector_get_validity(result.c_vector()));
+		return count - mask.CountValid(count);
+	}
+
+private:
+	FunctionProfile *profile;
+	Executor &executor;
+	Vector &result;
+	idx_t count;
+	std::chrono::steady_clock::time_point start;
+};
+
+struct FunctionProfileStatsOperator {
+	struct BIND_DATA {};
+	struct GLOBAL_STATE {
+		std::vector<FunctionProfileSnapshot> profiles;
+		idx_t offset = 0;
+	};
+
+	static void Bind(TableFunctionBindInfo &info, BIND_DATA &) {
+		info.AddResultColumn("function_name", LogicalType::VARCHAR());
+		info.AddResultColumn("rows", LogicalType::UBIGINT());
+		info.AddResultColumn("chunks", LogicalType::UBIGINT());
+		info.AddResultColumn("null_rows", LogicalType::UBIGINT());
+		info.AddResultColumn("errors", LogicalType::UBIGINT());
+		info.AddResultColumn("total_ns", LogicalType::UBIGINT());
+	}
+
+	static void Init(TableFunctionInitInfo &info, BIND_DATA &, GLOBAL_STATE &state) {
+		info.SetMaxThreads(1);
+		state.profiles = FunctionProfiler::Get().Snapshot();
+	}
+
+	static void Scan(BIND_DATA &, GLOBAL_STATE &state, DataChunk &output) {
+		auto name_vector = output.GetVector(0);
+		Vector counter_vectors[] = {output.GetVector(1), output.GetVector(2), output.GetVector(3), output.GetVector(4),
+		                            output.GetVector(5)};
+		idx_t row = 0;
+		for (; row < duckdb_vector_size() && state.offset < state.profiles.size(); row++, state.offset++) {
+			auto &profile = state.profiles[state.offset];
+			PrimitiveType<string_t>::AssignResult(
+			    name_vector, row, string_t(profile.name.c_str(), static_cast<uint32_t>(profile.name.size())));
+			uint64_t counters[] = {profile.rows, profile.chunks, profile.null_rows, profile.errors,
+			                       profile.nanoseconds};
+			for (idx_t c = 0; c < 5; c++) {
+				PrimitiveType<uint64_t>::AssignResult(counter_vectors[c], row, counters[c]);
+			}
+		}
+		output.SetSize(row);
+	}
+};
+
+//! stable_udf_stats() - the rows, chunks, NULL results, errors and time spent per scalar function. Only populated when
+//! the extension is compiled with DUCKDB_STABLE_PROFILING.
+class FunctionProfileStatsFunction : public StandardTableFunction<FunctionProfileStatsOperator> {
+public:
+	const char *Name() const override {
+		return "stable_udf_stats";
+	}
+};
+
+} // namespace duckdb_stable
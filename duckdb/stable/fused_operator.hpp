@@ -0,0 +1,160 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/fused_operator.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+
+#include <utility>
+
+namespace duckdb_stable {
+
+//! How Fused invokes an operator: with its STATIC_DATA as the last argument if it declares one, like
+//! UnaryFunctionExt does, and without otherwise.
+template <class OP, class = void>
+struct FusedStep {
+	struct DATA {};
+
+	template <class... ARGS>
+	static auto Call(DATA &, const ARGS &...args) -> decltype(OP::Operation(args...)) {
+		return OP::Operation(args...);
+	}
+};
+
+template <class OP>
+struct FusedStep<OP, decltype(void(static_cast<typename OP::STATIC_DATA *>(nullptr)))> {
+	using DATA = typename OP::STATIC_DATA;
+
+	template <class... ARGS>
+	static auto Call(DATA &data, const ARGS &...args) -> decltype(OP::Operation(args..., data)) {
+		return OP::Operation(args..., data);
+	}
+};
+
+//! The value an operator produces, without the ResultValue wrapper of operators that can return NULL.
+template <class T>
+struct FusedValue {
+	using type = T;
+};
+
+template <class T>
+struct FusedValue<ResultValue<T>> {
+	using type = T;
+};
+
+template <class OP, class... ARGS>
+struct FusedStepResult {
+	using type = typename FusedValue<decltype(FusedStep<OP>::Call(std::declval<typename FusedStep<OP>::DATA &>(),
+	                                                              std::declval<const ARGS &>()...))>::type;
+};
+
+//! The STATIC_DATA of every operator in the chain. Each operator has its own, so an operator can read the
+//! intermediate its predecessor left in its buffer while building its own result.
+template <class... OPS>
+struct FusedData {};
+
+template <class OP, class... OPS>
+struct FusedData<OP, OPS...> {
+	typename FusedStep<OP>::DATA head;
+	FusedData<OPS...> tail;
+};
+
+//! Passes a value of type INPUT through the operators OPS, in order.
+template <class INPUT, class... OPS>
+struct FusedChain {
+	using RESULT = INPUT;
+
+	static ResultValue<RESULT> Apply(const INPUT &input, FusedData<> &) {
+		return input;
+	}
+};
+
+//! Continues the chain with the result of the previous operator - a NULL ends it.
+template <class CHAIN, class T, class DATA>
+inline ResultValue<typename CHAIN::RESULT> FusedContinue(const T &value, DATA &data) {
+	return CHAIN::Apply(value, data);
+}
+
+template <class CHAIN, class T, class DATA>
+inline ResultValue<typename CHAIN::RESULT> FusedContinue(const ResultValue<T> &value, DATA &data) {
+	if (value.is_null) {
+		return nullptr;
+	}
+	return CHAIN::Apply(value.val, data);
+}
+
+template <class INPUT, class OP, class... OPS>
+struct FusedChain<INPUT, OP, OPS...> {
+	using NEXT = FusedChain<typename FusedStepResult<OP, INPUT>::type, OPS...>;
+	using RESULT = typename NEXT::RESULT;
+
+	static_assert(OperatorNullHandling<OP>::value == FunctionNullHandling::DEFAULT_NULL_HANDLING,
+	              "Only the first operator of a Fused chain can handle NULLs itself");
+
+	static ResultValue<RESULT> Apply(const INPUT &input, FusedData<OP, OPS...> &data) {
+		return FusedContinue<NEXT>(FusedStep<OP>::Call(data.head, input), data.tail);
+	}
+};
+
+//! The least stable of the operators.
+template <class... OPS>
+struct FusedStability {
+	static constexpr FunctionStability value = FunctionStability::CONSISTENT;
+};
+
+template <class OP, class... OPS>
+struct FusedStability<OP, OPS...> {
+	static constexpr FunctionStability value =
+	    OperatorStability<OP>::value > FusedStability<OPS...>::value ? OperatorStability<OP>::value
+	                                                                 : FusedStability<OPS...>::value;
+};
+
+//! An operator that applies OP to the inputs and then OPS to the result in turn, e.g.
+//! Fused<AsciiLowerOperator, ValidUTF8Operator> computes is_valid_utf8(ascii_lower(input)) in one row kernel. The
+//! intermediates stay in locals or in the STATIC_DATA buffers of the operators that built them, instead of being
+//! written to a vector between functions.
+//!
+//! OP may be unary or binary (and may handle NULLs itself), the operators after it are unary. An operator that
+//! returns a NULL ResultValue makes the row NULL without invoking the rest of the chain, errors are reported by the
+//! executor as usual. The last operator must return the ARG_TYPE of the result type (or a ResultValue of it). Use it
+//! through FusedUnaryFunction or FusedBinaryFunction.
+template <class OP, class... OPS>
+struct Fused {
+	using STATIC_DATA = FusedData<OP, OPS...>;
+
+	static constexpr FunctionStability STABILITY = FusedStability<OP, OPS...>::value;
+	static constexpr FunctionNullHandling NULL_HANDLING = OperatorNullHandling<OP>::value;
+
+	template <class A>
+	static ResultValue<typename FusedChain<typename FusedStepResult<OP, A>::type, OPS...>::RESULT>
+	Operation(const A &a, STATIC_DATA &data) {
+		using CHAIN = FusedChain<typename FusedStepResult<OP, A>::type, OPS...>;
+		return FusedContinue<CHAIN>(FusedStep<OP>::Call(data.head, a), data.tail);
+	}
+
+	template <class A, class B>
+	static ResultValue<typename FusedChain<typename FusedStepResult<OP, A, B>::type, OPS...>::RESULT>
+	Operation(const A &a, const B &b, STATIC_DATA &data) {
+		using CHAIN = FusedChain<typename FusedStepResult<OP, A, B>::type, OPS...>;
+		return FusedContinue<CHAIN>(FusedStep<OP>::Call(data.head, a, b), data.tail);
+	}
+};
+
+//! name(INPUT) -> RESULT over the operator chain OPS, see Fused.
+template <class INPUT_TYPE_T, class RETURN_TYPE_T, class... OPS>
+class FusedUnaryFunction
+    : public UnaryFunctionExt<Fused<OPS...>, INPUT_TYPE_T, RETURN_TYPE_T, typename Fused<OPS...>::STATIC_DATA> {};
+
+//! name(A, B) -> RESULT over the operator chain OPS - the first operator is binary, see Fused.
+template <class A_TYPE_T, class B_TYPE_T, class RETURN_TYPE_T, class... OPS>
+class FusedBinaryFunction : public BinaryFunctionExt<Fused<OPS...>, A_TYPE_T, B_TYPE_T, RETURN_TYPE_T,
+                                                     typename Fused<OPS...>::STATIC_DATA> {};
+
+} // namespace duckdb_stable
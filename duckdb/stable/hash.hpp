@@ -0,0 +1,540 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/hash.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/data_chunk.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/function_overloads.hpp"
+#include "duckdb/stable/hugeint.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/registration_builder.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/string_type.hpp"
+#include "duckdb/stable/uhugeint.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+#include "duckdb/stable/vector.hpp"
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! Fast non-cryptographic hashes. 64-bit hashes mix fixed-width values with the MurmurHash3 finalizer and hash
+//! strings with XXH64 - strings of up to string_t::INLINE_LENGTH bytes, which DuckDB stores inline, are hashed from
+//! their 16 inlined bytes instead. 128-bit hashes are MurmurHash3_x64_128 of the bytes of the value.
+//! Floating point values are hashed as doubles, with -0.0 and all NaNs normalized, so that equal values hash equally.
+struct HashUtil {
+	//! The hash of NULL.
+	static constexpr uint64_t NULL_HASH = 0xbf58476d1ce4e5b9ULL;
+	//! The hash of no values, e.g. combined_hash() without arguments.
+	static constexpr uint64_t EMPTY_HASH = 0x94d049bb133111ebULL;
+
+	static uint64_t Mix(uint64_t x) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return x;
+	}
+
+	//! Combine two hashes - the result depends on the order of the hashes.
+	static uint64_t CombineHash(uint64_t a, uint64_t b) {
+		return a ^ (b + 0x9e3779b97f4a7c15ULL + (a << 12) + (a >> 4));
+	}
+
+	static uhugeint_t CombineHash(const uhugeint_t &a, const uhugeint_t &b) {
+		return uhugeint_t(CombineHash(a.upper(), b.upper()), CombineHash(a.lower(), b.lower()));
+	}
+
+public:
+	template <class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+	static uint64_t Hash(T value) {
+		return Mix(static_cast<uint64_t>(value));
+	}
+	static uint64_t Hash(double value) {
+		return Mix(DoubleBits(value));
+	}
+	static uint64_t Hash(float value) {
+		return Hash(static_cast<double>(value));
+	}
+	static uint64_t Hash(const hugeint_t &value) {
+		return Mix(value.lower() ^ Mix(static_cast<uint64_t>(value.upper())));
+	}
+	static uint64_t Hash(const uhugeint_t &value) {
+		return Mix(value.lower() ^ Mix(value.upper()));
+	}
+	static uint64_t Hash(const string_t &value) {
+		if (value.IsInlined()) {
+			static_assert(sizeof(string_t) == 16, "string_t must have the layout of duckdb_string_t");
+			uint64_t words[2];
+			memcpy(words, &value, sizeof(words));
+			return HashInlined(words);
+		}
+		return XXH64(value.GetData(), value.GetSize());
+	}
+
+	//! The hash of a string given by its bytes - equal to the hash of the string_t of those bytes.
+	static uint64_t HashString(const char *data, idx_t size) {
+		if (size > string_t::INLINE_LENGTH) {
+			return XXH64(data, size);
+		}
+		// The layout of an inlined string: the length followed by the zero-padded bytes.
+		uint64_t words[2] = {0, 0};
+		auto length = static_cast<uint32_t>(size);
+		memcpy(words, &length, sizeof(length));
+		memcpy(reinterpret_cast<char *>(words) + sizeof(length), data, size);
+		return HashInlined(words);
+	}
+
+	template <class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+	static uhugeint_t Hash128(T value) {
+		auto extended = static_cast<uint64_t>(value);
+		return MurmurHash128(reinterpret_cast<const char *>(&extended), sizeof(extended));
+	}
+	static uhugeint_t Hash128(double value) {
+		auto bits = DoubleBits(value);
+		return MurmurHash128(reinterpret_cast<const char *>(&bits), sizeof(bits));
+	}
+	static uhugeint_t Hash128(float value) {
+		return Hash128(static_cast<double>(value));
+	}
+	static uhugeint_t Hash128(const hugeint_t &value) {
+		uint64_t words[2] = {value.lower(), static_cast<uint64_t>(value.upper())};
+		return MurmurHash128(reinterpret_cast<const char *>(words), sizeof(words));
+	}
+	static uhugeint_t Hash128(const uhugeint_t &value) {
+		uint64_t words[2] = {value.lower(), value.upper()};
+		return MurmurHash128(reinterpret_cast<const char *>(words), sizeof(words));
+	}
+	static uhugeint_t Hash128(const string_t &value) {
+		return MurmurHash128(value.GetData(), value.GetSize());
+	}
+
+public:
+	static uint64_t XXH64(const char *data, idx_t size, uint64_t seed = 0) {
+		auto end = data + size;
+		uint64_t hash;
+		if (size >= 32) {
+			auto limit = end - 32;
+			uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+			uint64_t v2 = seed + PRIME64_2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - PRIME64_1;
+			do {
+				v1 = XXH64Round(v1, Load64(data));
+				v2 = XXH64Round(v2, Load64(data + 8));
+				v3 = XXH64Round(v3, Load64(data + 16));
+				v4 = XXH64Round(v4, Load64(data + 24));
+				data += 32;
+			} while (data <= limit);
+			hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+			hash = XXH64MergeRound(hash, v1);
+			hash = XXH64MergeRound(hash, v2);
+			hash = XXH64MergeRound(hash, v3);
+			hash = XXH64MergeRound(hash, v4);
+		} else {
+			hash = seed + PRIME64_5;
+		}
+		hash += size;
+		for (; data + 8 <= end; data += 8) {
+			hash ^= XXH64Round(0, Load64(data));
+			hash = RotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+		}
+		if (data + 4 <= end) {
+			uint32_t word;
+			memcpy(&word, data, sizeof(word));
+			hash ^= static_cast<uint64_t>(word) * PRIME64_1;
+			hash = RotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+			data += 4;
+		}
+		for (; data < end; data++) {
+			hash ^= static_cast<unsigned char>(*data) * PRIME64_5;
+			hash = RotateLeft(hash, 11) * PRIME64_1;
+		}
+		hash ^= hash >> 33;
+		hash *= PRIME64_2;
+		hash ^= hash >> 29;
+		hash *= PRIME64_3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	//! MurmurHash3_x64_128 - the first 64 bits of the reference output are the lower half of the result.
+	static uhugeint_t MurmurHash128(const char *data, idx_t size, uint64_t seed = 0) {
+		const uint64_t c1 = 0x87c37b91114253d5ULL;
+		const uint64_t c2 = 0x4cf5ad432745937fULL;
+		uint64_t h1 = seed;
+		uint64_t h2 = seed;
+		auto blocks = size / 16;
+		for (idx_t i = 0; i < blocks; i++) {
+			auto k1 = Load64(data + i * 16);
+			auto k2 = Load64(data + i * 16 + 8);
+			h1 ^= RotateLeft(k1 * c1, 31) * c2;
+			h1 = (RotateLeft(h1, 27) + h2) * 5 + 0x52dce729;
+			h2 ^= RotateLeft(k2 * c2, 33) * c1;
+			h2 = (RotateLeft(h2, 31) + h1) * 5 + 0x38495ab5;
+		}
+		auto tail = reinterpret_cast<const unsigned char *>(data + blocks * 16);
+		auto remaining = size & 15;
+		uint64_t k1 = 0;
+		uint64_t k2 = 0;
+		for (idx_t i = remaining; i > 8; i--) {
+			k2 |= static_cast<uint64_t>(tail[i - 1]) << ((i - 9) * 8);
+		}
+		for (idx_t i = std::min<idx_t>(remaining, 8); i > 0; i--) {
+			k1 |= static_cast<uint64_t>(tail[i - 1]) << ((i - 1) * 8);
+		}
+		if (remaining > 8) {
+			h2 ^= RotateLeft(k2 * c2, 33) * c1;
+		}
+		if (remaining > 0) {
+			h1 ^= RotateLeft(k1 * c1, 31) * c2;
+		}
+		h1 ^= size;
+		h2 ^= size;
+		h1 += h2;
+		h2 += h1;
+		h1 = Mix(h1);
+		h2 = Mix(h2);
+		h1 += h2;
+		h2 += h1;
+		return uhugeint_t(h2, h1);
+	}
+
+private:
+	static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+	static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+	static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+	static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+	static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+	static uint64_t RotateLeft(uint64_t x, int bits) {
+		return (x << bits) | (x >> (64 - bits));
+	}
+
+	static uint64_t Load64(const char *data) {
+		uint64_t result;
+		memcpy(&result, data, sizeof(result));
+		return result;
+	}
+
+	static uint64_t XXH64Round(uint64_t accumulator, uint64_t input) {
+		accumulator += input * PRIME64_2;
+		accumulator = RotateLeft(accumulator, 31);
+		return accumulator * PRIME64_1;
+	}
+
+	static uint64_t XXH64MergeRound(uint64_t accumulator, uint64_t value) {
+		accumulator ^= XXH64Round(0, value);
+		return accumulator * PRIME64_1 + PRIME64_4;
+	}
+
+	static uint64_t HashInlined(const uint64_t words[2]) {
+		return Mix(words[0] ^ Mix(words[1] ^ PRIME64_3));
+	}
+
+	static uint64_t DoubleBits(double value) {
+		if (value == 0) {
+			value = 0;
+		} else if (value != value) {
+			value = std::numeric_limits<double>::quiet_NaN();
+		}
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+};
+
+//! Hashes whole vectors into an array of hashes, without a call or a try/catch per row. The validity of the input is
+//! read 64 rows at a time: runs without NULLs are hashed in a tight, branch-free loop over the data array (which the
+//! compiler can vectorize for fixed-width types), NULL rows hash to HashUtil::NULL_HASH.
+class VectorHash {
+public:
+	//! hashes[r] = the hash of row r
+	template <class T>
+	static void Hash(Vector &input, idx_t count, uint64_t *hashes) {
+		Execute<T, Hash64, false>(input, count, hashes);
+	}
+	//! hashes[r] = the combination of hashes[r] and the hash of row r
+	template <class T>
+	static void CombineHash(Vector &input, idx_t count, uint64_t *hashes) {
+		Execute<T, Hash64, true>(input, count, hashes);
+	}
+	template <class T>
+	static void Hash128(Vector &input, idx_t count, uhugeint_t *hashes) {
+		Execute<T, Hash128Bit, false>(input, count, hashes);
+	}
+	template <class T>
+	static void CombineHash128(Vector &input, idx_t count, uhugeint_t *hashes) {
+		Execute<T, Hash128Bit, true>(input, count, hashes);
+	}
+
+	//! Hash a vector of any hashable type - the type is dispatched once per vector.
+	static void Hash(Vector &input, idx_t count, uint64_t *hashes, bool combine) {
+		Dispatch<Hash64>(input, count, hashes, combine);
+	}
+	static void Hash128(Vector &input, idx_t count, uhugeint_t *hashes, bool combine) {
+		Dispatch<Hash128Bit>(input, count, hashes, combine);
+	}
+
+private:
+	struct Hash64 {
+		using HASH_TYPE = uint64_t;
+
+		template <class T>
+		static uint64_t Operation(const T &value) {
+			return HashUtil::Hash(value);
+		}
+		static uint64_t NullHash() {
+			return HashUtil::NULL_HASH;
+		}
+	};
+
+	struct Hash128Bit {
+		using HASH_TYPE = uhugeint_t;
+
+		template <class T>
+		static uhugeint_t Operation(const T &value) {
+			return HashUtil::Hash128(value);
+		}
+		static uhugeint_t NullHash() {
+			return uhugeint_t(HashUtil::NULL_HASH, HashUtil::NULL_HASH);
+		}
+	};
+
+	template <class T, class OP, bool COMBINE>
+	static void Apply(typename OP::HASH_TYPE &hash, const typename OP::HASH_TYPE &value) {
+		hash = COMBINE ? HashUtil::CombineHash(hash, value) : value;
+	}
+
+	template <class T, class OP, bool COMBINE>
+	static void Execute(Vector &input, idx_t count, typename OP::HASH_TYPE *hashes) {
+		auto data = reinterpret_cast<const T *>(duckdb_vector_get_data(input.c_vector()));
+		ValidityMask mask(duckdb_vector_get_validity(input.c_vector()));
+		auto null_hash = OP::NullHash();
+		for (idx_t base = 0; base < count; base += ValidityMask::BITS_PER_WORD) {
+			auto end = std::min<idx_t>(base + ValidityMask::BITS_PER_WORD, count);
+			auto word = mask.GetWord(base / ValidityMask::BITS_PER_WORD);
+			if (word == ValidityMask::ALL_VALID) {
+				for (idx_t r = base; r < end; r++) {
+					Apply<T, OP, COMBINE>(hashes[r], OP::Operation(data[r]));
+				}
+				continue;
+			}
+			for (idx_t r = base; r < end; r++) {
+				// The data of NULL rows is undefined (e.g. a dangling string pointer) and is never read.
+				Apply<T, OP, COMBINE>(hashes[r],
+				                      ValidityMask::RowIsValid(word, r - base) ? OP::Operation(data[r]) : null_hash);
+			}
+		}
+	}
+
+	//! Dispatches on the physical type, so e.g. TIMESTAMP is hashed as an int64_t, and DECIMAL and ENUM values as their
+	//! internal integers.
+	template <class OP, class HASH_TYPE>
+	static void Dispatch(Vector &input, idx_t count, HASH_TYPE *hashes, bool combine) {
+		auto type = input.GetLogicalType();
+		switch (PhysicalTypeId(type.c_logical_type())) {
+		case DUCKDB_TYPE_BOOLEAN:
+			return DispatchCombine<bool, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_TINYINT:
+			return DispatchCombine<int8_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_SMALLINT:
+			return DispatchCombine<int16_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_INTEGER:
+			return DispatchCombine<int32_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_BIGINT:
+			return DispatchCombine<int64_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_UTINYINT:
+			return DispatchCombine<uint8_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_USMALLINT:
+			return DispatchCombine<uint16_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_UINTEGER:
+			return DispatchCombine<uint32_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_UBIGINT:
+			return DispatchCombine<uint64_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_HUGEINT:
+			return DispatchCombine<hugeint_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_UHUGEINT:
+			return DispatchCombine<uhugeint_t, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_FLOAT:
+			return DispatchCombine<float, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_DOUBLE:
+			return DispatchCombine<double, OP>(input, count, hashes, combine);
+		case DUCKDB_TYPE_VARCHAR:
+			return DispatchCombine<string_t, OP>(input, count, hashes, combine);
+		default:
+			throw Exception(std::string("Cannot hash values of type ") + TypeIdToString(type.c_type()));
+		}
+	}
+
+	template <class T, class OP>
+	static void DispatchCombine(Vector &input, idx_t count, typename OP::HASH_TYPE *hashes, bool combine) {
+		if (combine) {
+			Execute<T, OP, true>(input, count, hashes);
+		} else {
+			Execute<T, OP, false>(input, count, hashes);
+		}
+	}
+};
+
+//! The types that the typed hash functions are instantiated for.
+using HashableTypes = TypeList<bool, int8_t, int16_t, int32_t, int64_t, hugeint_t, uint8_t, uint16_t, uint32_t,
+                               uint64_t, uhugeint_t, float, double, string_t>;
+
+//! (T) -> UBIGINT: the 64-bit hash of the argument. NULL hashes to HashUtil::NULL_HASH.
+template <class T>
+class HashFunction : public BaseUnaryFunction<PrimitiveType<T>, PrimitiveType<uint64_t>> {
+public:
+	static void Execute(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto input_vec = chunk.GetVector(0);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		auto hashes = reinterpret_cast<uint64_t *>(duckdb_vector_get_data(output));
+		VectorHash::Hash<T>(input_vec, count, hashes);
+	}
+
+	duckdb_scalar_function_t GetFunction() const override {
+		return Execute;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return FunctionNullHandling::SPECIAL_HANDLING;
+	}
+};
+
+//! (T) -> UHUGEINT: the 128-bit hash of the argument. NULL hashes to a constant.
+template <class T>
+class Hash128Function : public BaseUnaryFunction<PrimitiveType<T>, PrimitiveType<uhugeint_t>> {
+public:
+	static void Execute(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto input_vec = chunk.GetVector(0);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		auto hashes = reinterpret_cast<uhugeint_t *>(duckdb_vector_get_data(output));
+		VectorHash::Hash128<T>(input_vec, count, hashes);
+	}
+
+	duckdb_scalar_function_t GetFunction() const override {
+		return Execute;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return FunctionNullHandling::SPECIAL_HANDLING;
+	}
+};
+
+//! (ANY, ...) -> UBIGINT (or UHUGEINT): the combined hash of all arguments in argument order, e.g. a fingerprint
+//! over several columns for deduplication or sharding. The type of every column is dispatched once per chunk. Without
+//! arguments every row hashes to HashUtil::EMPTY_HASH.
+template <bool WIDE = false>
+class CombinedHashFunction : public ScalarFunction {
+public:
+	using HASH_TYPE = typename std::conditional<WIDE, uhugeint_t, uint64_t>::type;
+
+	LogicalType ReturnType() const override {
+		return TemplateToType::Intern<PrimitiveType<HASH_TYPE>>();
+	}
+	std::vector<LogicalType> Arguments() const override {
+		return std::vector<LogicalType>();
+	}
+	bool HasVarargs() const override {
+		return true;
+	}
+	LogicalType VarargsType() const override {
+		return LogicalType::ANY();
+	}
+	FunctionNullHandling NullHandling() const override {
+		return FunctionNullHandling::SPECIAL_HANDLING;
+	}
+
+	static void Execute(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		auto hashes = reinterpret_cast<HASH_TYPE *>(duckdb_vector_get_data(output));
+		if (chunk.ColumnCount() == 0) {
+			FillEmpty(count, hashes);
+			return;
+		}
+		try {
+			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+				auto vector = chunk.GetVector(c);
+				HashColumn(vector, count, hashes, c > 0);
+			}
+		} catch (std::exception &ex) {
+			duckdb_scalar_function_set_error(info, ex.what());
+		}
+	}
+
+	duckdb_scalar_function_t GetFunction() const override {
+		return Execute;
+	}
+
+private:
+	static void HashColumn(Vector &vector, idx_t count, uint64_t *hashes, bool combine) {
+		VectorHash::Hash(vector, count, hashes, combine);
+	}
+	static void HashColumn(Vector &vector, idx_t count, uhugeint_t *hashes, bool combine) {
+		VectorHash::Hash128(vector, count, hashes, combine);
+	}
+	static void FillEmpty(idx_t count, uint64_t *hashes) {
+		for (idx_t r = 0; r < count; r++) {
+			hashes[r] = HashUtil::EMPTY_HASH;
+		}
+	}
+	static void FillEmpty(idx_t count, uhugeint_t *hashes) {
+		for (idx_t r = 0; r < count; r++) {
+			hashes[r] = uhugeint_t(HashUtil::EMPTY_HASH, HashUtil::EMPTY_HASH);
+		}
+	}
+};
+
+//! Adds a hash function - HashFunction or Hash128Function - for every type in TYPES, e.g.
+//! "HashOverloads<HashFunction>::AddTo(builder, "fingerprint")".
+template <template <class> class FUNCTION, class TYPES = HashableTypes>
+struct HashOverloads;
+
+template <template <class> class FUNCTION, class... TYPES>
+struct HashOverloads<FUNCTION, TypeList<TYPES...>> {
+	static void AddTo(ScalarFunctionSet &set) {
+		int expand[] = {0, (AddFunction<TYPES>(set), 0)...};
+		(void)expand;
+	}
+
+	static void AddTo(RegistrationBuilder &builder, const char *name) {
+		int expand[] = {0, (builder.AddFunction<FUNCTION<TYPES>>(name), 0)...};
+		(void)expand;
+	}
+
+private:
+	template <class T>
+	static void AddFunction(ScalarFunctionSet &set) {
+		FUNCTION<T> function;
+		set.AddFunction(function);
+	}
+};
+
+} // namespace duckdb_stable
@@ -23,6 +23,7 @@ public:
 	}
 	hugeint_t(const hugeint_t &other) : value(other.value) {
 	}
+	hugeint_t &operator=(const hugeint_t &other) = default;
 	hugeint_t(int64_t upper, uint64_t lower) {
 		value.lower = lower;
 		value.upper = upper;
@@ -115,6 +116,57 @@ public:
 		return result;
 	}
 
+	static bool try_multiply(hugeint_t lhs, hugeint_t rhs, hugeint_t &result) {
+		bool negative = (lhs.value.upper < 0) != (rhs.value.upper < 0);
+		uint64_t lhs_upper, lhs_lower, rhs_upper, rhs_lower;
+		lhs.magnitude(lhs_upper, lhs_lower);
+		rhs.magnitude(rhs_upper, rhs_lower);
+		if (lhs_upper != 0 && rhs_upper != 0) {
+			return false;
+		}
+		uint64_t upper, lower;
+		multiply_64(lhs_lower, rhs_lower, upper, lower);
+		// At most one of the cross products is non-zero, and it must fit in the upper 64 bits.
+		uint64_t cross_upper, cross_lower;
+		multiply_64(lhs_upper | rhs_upper, lhs_upper ? rhs_lower : lhs_lower, cross_upper, cross_lower);
+		if (cross_upper != 0 || upper + cross_lower < upper) {
+			return false;
+		}
+		upper += cross_lower;
+		// The magnitude can be up to 2^127 for negative results, and up to 2^127 - 1 for positive ones.
+		auto sign_bit = uint64_t(1) << 63;
+		if (upper > sign_bit || (upper == sign_bit && (lower != 0 || !negative))) {
+			return false;
+		}
+		result = from_magnitude(upper, lower, negative);
+		return true;
+	}
+
+	hugeint_t multiply(hugeint_t rhs) const {
+		hugeint_t result;
+		if (!try_multiply(*this, rhs, result)) {
+			throw Exception("Failed to multiply hugeint: Out of range");
+		}
+		return result;
+	}
+
+	//! Divides by a non-zero divisor, rounding toward zero. The remainder is the magnitude of what was cut off.
+	hugeint_t divide(uint32_t divisor, uint32_t &remainder) const {
+		uint64_t upper, lower;
+		magnitude(upper, lower);
+		uint32_t limbs[] = {static_cast<uint32_t>(upper >> 32), static_cast<uint32_t>(upper),
+		                    static_cast<uint32_t>(lower >> 32), static_cast<uint32_t>(lower)};
+		uint64_t carry = 0;
+		for (auto &limb : limbs) {
+			auto current = (carry << 32) | limb;
+			limb = static_cast<uint32_t>(current / divisor);
+			carry = current % divisor;
+		}
+		remainder = static_cast<uint32_t>(carry);
+		return from_magnitude((uint64_t(limbs[0]) << 32) | limbs[1], (uint64_t(limbs[2]) << 32) | limbs[3],
+		                      value.upper < 0);
+	}
+
 	bool operator==(const hugeint_t &rhs) const {
 		return value.lower == rhs.value.lower && value.upper == rhs.value.upper;
 	}
@@ -135,10 +187,10 @@ public:
 		return upper_bigger || (upper_equal && lower_bigger_equal);
 	}
 	bool operator<(const hugeint_t &rhs) const {
-		return !(rhs >= *this);
+		return !(*this >= rhs);
 	}
 	bool operator<=(const hugeint_t &rhs) const {
-		return !(rhs > *this);
+		return !(*this > rhs);
 	}
 	hugeint_t operator+(const hugeint_t &rhs) const {
 		return hugeint_t(value.upper + rhs.value.upper + ((value.lower + rhs.value.lower) < value.lower),
@@ -149,6 +201,38 @@ public:
 		                 value.lower - rhs.value.lower);
 	}
 
+private:
+	//! The absolute value as an unsigned 128-bit number, which also holds the magnitude of the minimum.
+	void magnitude(uint64_t &upper, uint64_t &lower) const {
+		upper = static_cast<uint64_t>(value.upper);
+		lower = value.lower;
+		if (value.upper < 0) {
+			lower = ~lower + 1;
+			upper = ~upper + (lower == 0);
+		}
+	}
+
+	static hugeint_t from_magnitude(uint64_t upper, uint64_t lower, bool negative) {
+		if (negative) {
+			lower = ~lower + 1;
+			upper = ~upper + (lower == 0);
+		}
+		return hugeint_t(static_cast<int64_t>(upper), lower);
+	}
+
+	static void multiply_64(uint64_t lhs, uint64_t rhs, uint64_t &upper, uint64_t &lower) {
+		auto lhs_lo = lhs & 0xFFFFFFFF;
+		auto lhs_hi = lhs >> 32;
+		auto rhs_lo = rhs & 0xFFFFFFFF;
+		auto rhs_hi = rhs >> 32;
+		auto lo_lo = lhs_lo * rhs_lo;
+		auto lo_hi = lhs_lo * rhs_hi;
+		auto hi_lo = lhs_hi * rhs_lo;
+		auto middle = (lo_lo >> 32) + (lo_hi & 0xFFFFFFFF) + (hi_lo & 0xFFFFFFFF);
+		lower = (lo_lo & 0xFFFFFFFF) | (middle << 32);
+		upper = lhs_hi * rhs_hi + (lo_hi >> 32) + (hi_lo >> 32) + (middle >> 32);
+	}
+
 private:
 	duckdb_hugeint value;
 };
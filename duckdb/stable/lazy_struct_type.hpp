@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/lazy_struct_type.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+#include "duckdb/stable/vector.hpp"
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! The states of all fields of a struct vector, prepared once per chunk. Preparing a field only looks up its data and
+//! validity, no row is read until an operator asks for it.
+template <class... CHILD_TYPES>
+struct LazyStructTypeState {
+	static_assert(sizeof...(CHILD_TYPES) > 0, "A struct needs at least one field");
+
+	std::tuple<typename CHILD_TYPES::STRUCT_STATE...> children;
+	uint64_t *validity = nullptr;
+
+	void PrepareVector(Vector &input, idx_t count) {
+		PrepareChildren(input, count, std::integral_constant<idx_t, 0>());
+		validity = duckdb_vector_get_validity(input.c_vector());
+	}
+
+private:
+	template <idx_t I>
+	void PrepareChildren(Vector &input, idx_t count, std::integral_constant<idx_t, I>) {
+		Vector child(duckdb_struct_vector_get_child(input.c_vector(), I));
+		std::get<I>(children).PrepareVector(child, count);
+		PrepareChildren(input, count, std::integral_constant<idx_t, I + 1>());
+	}
+	void PrepareChildren(Vector &, idx_t, std::integral_constant<idx_t, sizeof...(CHILD_TYPES)>) {
+	}
+};
+
+//! A row of a struct vector. Fields are only constructed when they are read with Get<I>(), so an operator that reads
+//! two fields of a wide struct pays for two fields (e.g. one string_t each), not for all of them.
+template <class... CHILD_TYPES>
+class LazyStruct {
+public:
+	template <idx_t I>
+	using FIELD_TYPE = typename std::tuple_element<I, std::tuple<CHILD_TYPES...>>::type;
+
+	LazyStruct() : state(nullptr), row(0) {
+	}
+
+public:
+	//! Reads field I. The value is unspecified if the field is NULL, see FieldIsValid.
+	template <idx_t I>
+	typename FIELD_TYPE<I>::ARG_TYPE Get() const {
+		typename FIELD_TYPE<I>::ARG_TYPE result;
+		FIELD_TYPE<I>::ConstructType(std::get<I>(state->children), row, result);
+		return result;
+	}
+
+	template <idx_t I>
+	bool FieldIsValid() const {
+		return ValidityMask(std::get<I>(state->children).validity).RowIsValid(row);
+	}
+
+	idx_t Row() const {
+		return row;
+	}
+
+private:
+	template <class... TYPES>
+	friend struct LazyStructType;
+
+	LazyStructTypeState<CHILD_TYPES...> *state;
+	idx_t row;
+};
+
+//! A struct input whose fields are read on demand, e.g. LazyStructType<PrimitiveType<uint64_t>,
+//! PrimitiveType<string_t>, ...> with operators taking a LazyStruct<...> - unlike StructTypeTernary, which constructs
+//! every field of every row. It is an input type only: results are built with StructTypeTernary.
+template <class... CHILD_TYPES>
+struct LazyStructType {
+	using ARG_TYPE = LazyStruct<CHILD_TYPES...>;
+	using STRUCT_STATE = LazyStructTypeState<CHILD_TYPES...>;
+
+	static void ConstructType(STRUCT_STATE &state, idx_t r, ARG_TYPE &output) {
+		output.state = &state;
+		output.row = r;
+	}
+
+	//! The STRUCT type with the given field names, for the arguments of a function over this type.
+	static LogicalType CreateType(const char **child_names) {
+		std::vector<LogicalType> child_types;
+		AddChildTypes<CHILD_TYPES...>(child_types);
+		return LogicalType::STRUCT(child_types.data(), child_names, child_types.size());
+	}
+
+	//! The STRUCT type with fields named by position (v1, v2, ...), like the structs of row(). Functions over structs
+	//! with named fields override Arguments() with CreateType.
+	static LogicalType CreateLogicalType() {
+		std::vector<std::string> names;
+		std::vector<const char *> child_names;
+		for (idx_t i = 0; i < sizeof...(CHILD_TYPES); i++) {
+			names.push_back("v" + std::to_string(i + 1));
+		}
+		for (auto &name : names) {
+			child_names.push_back(name.c_str());
+		}
+		return CreateType(child_names.data());
+	}
+
+private:
+	template <class CHILD, class... REST>
+	static void AddChildTypes(std::vector<LogicalType> &child_types) {
+		child_types.push_back(TemplateToType::Convert<CHILD>());
+		AddChildTypes<REST...>(child_types);
+	}
+	template <class... REST>
+	static typename std::enable_if<sizeof...(REST) == 0>::type AddChildTypes(std::vector<LogicalType> &) {
+	}
+};
+
+} // namespace duckdb_stable
@@ -10,17 +10,21 @@
 
 #include "duckdb/stable/common.hpp"
 
+#include <string>
+#include <vector>
+
 namespace duckdb_stable {
 
 class LogicalType {
 public:
-	LogicalType(duckdb_logical_type logical_type_p) : logical_type(logical_type_p) {
+	LogicalType(duckdb_logical_type logical_type_p, const bool owning_p = true)
+	    : logical_type(logical_type_p), owning(owning_p) {
 	}
-	LogicalType(duckdb_type type_p) {
+	LogicalType(duckdb_type type_p) : owning(true) {
         logical_type = duckdb_create_logical_type(type_p);
 	}
 	~LogicalType() {
-		if (logical_type) {
+		if (logical_type && owning) {
 			duckdb_destroy_logical_type(&logical_type);
 		}
 	}
@@ -30,11 +34,13 @@ public:
 	LogicalType &operator=(const LogicalType &) = delete;
 
 	//! Enable move constructors.
-	LogicalType(LogicalType &&other) noexcept : logical_type(nullptr) {
+	LogicalType(LogicalType &&other) noexcept : logical_type(nullptr), owning(false) {
 		std::swap(logical_type, other.logical_type);
+		std::swap(owning, other.owning);
 	}
 	LogicalType &operator=(LogicalType &&other) noexcept {
 		std::swap(logical_type, other.logical_type);
+		std::swap(owning, other.owning);
 		return *this;
 	}
 
@@ -50,18 +56,68 @@ public:
 	static LogicalType VARCHAR() {
 		return LogicalType(DUCKDB_TYPE_VARCHAR);
 	}
+	static LogicalType TINYINT() {
+		return LogicalType(DUCKDB_TYPE_TINYINT);
+	}
+	static LogicalType SMALLINT() {
+		return LogicalType(DUCKDB_TYPE_SMALLINT);
+	}
+	static LogicalType INTEGER() {
+		return LogicalType(DUCKDB_TYPE_INTEGER);
+	}
+	static LogicalType BIGINT() {
+		return LogicalType(DUCKDB_TYPE_BIGINT);
+	}
 	static LogicalType UTINYINT() {
 		return LogicalType(DUCKDB_TYPE_UTINYINT);
 	}
 	static LogicalType USMALLINT() {
 		return LogicalType(DUCKDB_TYPE_USMALLINT);
 	}
+	static LogicalType UINTEGER() {
+		return LogicalType(DUCKDB_TYPE_UINTEGER);
+	}
+	static LogicalType UBIGINT() {
+		return LogicalType(DUCKDB_TYPE_UBIGINT);
+	}
+	static LogicalType FLOAT() {
+		return LogicalType(DUCKDB_TYPE_FLOAT);
+	}
+	static LogicalType DOUBLE() {
+		return LogicalType(DUCKDB_TYPE_DOUBLE);
+	}
 	static LogicalType HUGEINT() {
 		return LogicalType(DUCKDB_TYPE_HUGEINT);
 	}
+	static LogicalType UHUGEINT() {
+		return LogicalType(DUCKDB_TYPE_UHUGEINT);
+	}
+	//! Only valid as the varargs type of a function, which then accepts arguments of any type.
+	static LogicalType ANY() {
+		return LogicalType(DUCKDB_TYPE_ANY);
+	}
+	//! DuckDB stores the values as SMALLINT, INTEGER, BIGINT or HUGEINT, depending on the width (at most 38).
+	static LogicalType DECIMAL(uint8_t width, uint8_t scale) {
+		return LogicalType(duckdb_create_decimal_type(width, scale));
+	}
+	//! An ENUM over the values, in code order. DuckDB stores the codes as UTINYINT, USMALLINT or UINTEGER, depending on
+	//! the number of values.
+	static LogicalType ENUM(const char *const *values, idx_t n) {
+		return LogicalType(duckdb_create_enum_type(const_cast<const char **>(values), n));
+	}
+	static LogicalType ENUM(const std::vector<std::string> &values) {
+		std::vector<const char *> c_values;
+		for (auto &value : values) {
+			c_values.push_back(value.c_str());
+		}
+		return ENUM(c_values.data(), c_values.size());
+	}
 	static LogicalType STRUCT(LogicalType *child_types, const char **child_names, idx_t n) {
-        auto c_child_types = reinterpret_cast<duckdb_logical_type *>(child_types);
-		return LogicalType(duckdb_create_struct_type(c_child_types, child_names, n));
+		std::vector<duckdb_logical_type> c_child_types;
+		for (idx_t i = 0; i < n; i++) {
+			c_child_types.push_back(child_types[i].c_logical_type());
+		}
+		return LogicalType(duckdb_create_struct_type(c_child_types.data(), child_names, n));
 	}
 
 public:
@@ -75,6 +131,87 @@ public:
 
 private:
 	duckdb_logical_type logical_type;
+	bool owning;
 };
 
+//! The SQL name of a type id, for error messages.
+inline const char *TypeIdToString(duckdb_type id) {
+	switch (id) {
+	case DUCKDB_TYPE_BOOLEAN:
+		return "BOOLEAN";
+	case DUCKDB_TYPE_TINYINT:
+		return "TINYINT";
+	case DUCKDB_TYPE_SMALLINT:
+		return "SMALLINT";
+	case DUCKDB_TYPE_INTEGER:
+		return "INTEGER";
+	case DUCKDB_TYPE_BIGINT:
+		return "BIGINT";
+	case DUCKDB_TYPE_UTINYINT:
+		return "UTINYINT";
+	case DUCKDB_TYPE_USMALLINT:
+		return "USMALLINT";
+	case DUCKDB_TYPE_UINTEGER:
+		return "UINTEGER";
+	case DUCKDB_TYPE_UBIGINT:
+		return "UBIGINT";
+	case DUCKDB_TYPE_FLOAT:
+		return "FLOAT";
+	case DUCKDB_TYPE_DOUBLE:
+		return "DOUBLE";
+	case DUCKDB_TYPE_TIMESTAMP:
+		return "TIMESTAMP";
+	case DUCKDB_TYPE_DATE:
+		return "DATE";
+	case DUCKDB_TYPE_TIME:
+		return "TIME";
+	case DUCKDB_TYPE_INTERVAL:
+		return "INTERVAL";
+	case DUCKDB_TYPE_HUGEINT:
+		return "HUGEINT";
+	case DUCKDB_TYPE_UHUGEINT:
+		return "UHUGEINT";
+	case DUCKDB_TYPE_VARCHAR:
+		return "VARCHAR";
+	case DUCKDB_TYPE_BLOB:
+		return "BLOB";
+	case DUCKDB_TYPE_DECIMAL:
+		return "DECIMAL";
+	case DUCKDB_TYPE_TIMESTAMP_S:
+		return "TIMESTAMP_S";
+	case DUCKDB_TYPE_TIMESTAMP_MS:
+		return "TIMESTAMP_MS";
+	case DUCKDB_TYPE_TIMESTAMP_NS:
+		return "TIMESTAMP_NS";
+	case DUCKDB_TYPE_ENUM:
+		return "ENUM";
+	case DUCKDB_TYPE_LIST:
+		return "LIST";
+	case DUCKDB_TYPE_STRUCT:
+		return "STRUCT";
+	case DUCKDB_TYPE_MAP:
+		return "MAP";
+	case DUCKDB_TYPE_ARRAY:
+		return "ARRAY";
+	case DUCKDB_TYPE_UUID:
+		return "UUID";
+	case DUCKDB_TYPE_UNION:
+		return "UNION";
+	case DUCKDB_TYPE_BIT:
+		return "BIT";
+	case DUCKDB_TYPE_TIME_TZ:
+		return "TIME WITH TIME ZONE";
+	case DUCKDB_TYPE_TIMESTAMP_TZ:
+		return "TIMESTAMP WITH TIME ZONE";
+	case DUCKDB_TYPE_ANY:
+		return "ANY";
+	case DUCKDB_TYPE_VARINT:
+		return "VARINT";
+	case DUCKDB_TYPE_SQLNULL:
+		return "NULL";
+	default:
+		return "INVALID";
+	}
+}
+
 } // namespace duckdb_stable
@@ -0,0 +1,244 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/lookup_table.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/mapped_file.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/string_type.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace duckdb_stable {
+
+//! The file starts with a header, followed by the entries sorted by key and the key and value bytes.
+struct LookupTableHeader {
+	static const char *Magic() {
+		return "DSTBLKUP";
+	}
+	static constexpr uint32_t VERSION = 1;
+
+	char magic[8];
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t entry_count;
+	uint64_t string_offset;
+};
+
+struct LookupTableEntry {
+	//! The first 8 bytes of the key in big-endian order - comparing prefixes compares keys without touching them.
+	uint64_t prefix;
+	uint64_t key_offset;
+	uint64_t value_offset;
+	uint32_t key_length;
+	uint32_t value_length;
+
+	static uint64_t GetPrefix(const char *key, idx_t length) {
+		uint64_t prefix = 0;
+		for (idx_t i = 0; i < sizeof(uint64_t); i++) {
+			prefix <<= 8;
+			if (i < length) {
+				prefix |= static_cast<unsigned char>(key[i]);
+			}
+		}
+		return prefix;
+	}
+};
+
+//! Builds a lookup table file from key-value pairs. Keys must be unique.
+class LookupTableBuilder {
+public:
+	void Add(std::string key, std::string value) {
+		entries.emplace_back(std::move(key), std::move(value));
+	}
+
+	idx_t Size() const {
+		return entries.size();
+	}
+
+	void Write(const std::string &path) {
+		std::sort(entries.begin(), entries.end());
+		for (idx_t i = 1; i < entries.size(); i++) {
+			if (entries[i - 1].first == entries[i].first) {
+				throw Exception("Duplicate key \"" + entries[i].first + "\" in lookup table");
+			}
+		}
+
+		LookupTableHeader header;
+		memcpy(header.magic, LookupTableHeader::Magic(), sizeof(header.magic));
+		header.version = LookupTableHeader::VERSION;
+		header.reserved = 0;
+		header.entry_count = entries.size();
+		header.string_offset = sizeof(LookupTableHeader) + entries.size() * sizeof(LookupTableEntry);
+
+		std::vector<LookupTableEntry> table_entries;
+		table_entries.reserve(entries.size());
+		uint64_t offset = 0;
+		for (auto &entry : entries) {
+			if (entry.first.size() > UINT32_MAX || entry.second.size() > UINT32_MAX) {
+				throw Exception("Lookup table keys and values are limited to 4GB");
+			}
+			LookupTableEntry table_entry;
+			table_entry.prefix = LookupTableEntry::GetPrefix(entry.first.c_str(), entry.first.size());
+			table_entry.key_offset = offset;
+			table_entry.key_length = static_cast<uint32_t>(entry.first.size());
+			offset += entry.first.size();
+			table_entry.value_offset = offset;
+			table_entry.value_length = static_cast<uint32_t>(entry.second.size());
+			offset += entry.second.size();
+			table_entries.push_back(table_entry);
+		}
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			throw Exception("Could not open file \"" + path + "\" for writing");
+		}
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(table_entries.data()),
+		           static_cast<std::streamsize>(table_entries.size() * sizeof(LookupTableEntry)));
+		for (auto &entry : entries) {
+			file.write(entry.first.data(), static_cast<std::streamsize>(entry.first.size()));
+			file.write(entry.second.data(), static_cast<std::streamsize>(entry.second.size()));
+		}
+		file.close();
+		if (!file) {
+			throw Exception("Could not write lookup table \"" + path + "\"");
+		}
+	}
+
+private:
+	std::vector<std::pair<std::string, std::string>> entries;
+};
+
+//! A read-only table that is memory-mapped from a file written by LookupTableBuilder. Lookups are a binary search
+//! over the mapped entries and return values that point directly into the mapping, so nothing is loaded up front
+//! and the pages are shared between processes. The file must be written on a machine with the same endianness.
+class LookupTable {
+public:
+	explicit LookupTable(const std::string &path) : file(path) {
+		if (file.Size() < sizeof(LookupTableHeader)) {
+			throw Exception("\"" + path + "\" is not a lookup table");
+		}
+		auto &header = *reinterpret_cast<const LookupTableHeader *>(file.Data());
+		if (memcmp(header.magic, LookupTableHeader::Magic(), sizeof(header.magic)) != 0) {
+			throw Exception("\"" + path + "\" is not a lookup table");
+		}
+		if (header.version != LookupTableHeader::VERSION) {
+			throw Exception("Unsupported lookup table version in \"" + path + "\"");
+		}
+		// Validate everything once, so lookups can trust the offsets.
+		auto entries_size = (file.Size() - sizeof(LookupTableHeader)) / sizeof(LookupTableEntry);
+		if (header.entry_count > entries_size ||
+		    header.string_offset != sizeof(LookupTableHeader) + header.entry_count * sizeof(LookupTableEntry)) {
+			throw Exception("Corrupt lookup table \"" + path + "\"");
+		}
+		entries = reinterpret_cast<const LookupTableEntry *>(file.Data() + sizeof(LookupTableHeader));
+		entry_count = header.entry_count;
+		strings = file.Data() + header.string_offset;
+		auto string_size = file.Size() - header.string_offset;
+		for (idx_t i = 0; i < entry_count; i++) {
+			auto &entry = entries[i];
+			if (entry.key_offset > string_size || entry.key_length > string_size - entry.key_offset ||
+			    entry.value_offset > string_size || entry.value_length > string_size - entry.value_offset) {
+				throw Exception("Corrupt lookup table \"" + path + "\"");
+			}
+		}
+	}
+
+	static std::shared_ptr<LookupTable> Open(const std::string &path) {
+		return std::make_shared<LookupTable>(path);
+	}
+
+public:
+	idx_t Size() const {
+		return entry_count;
+	}
+
+	//! Returns whether the key exists - the value references the mapped file.
+	bool Lookup(const char *key, uint32_t key_length, string_t &value) const {
+		auto prefix = LookupTableEntry::GetPrefix(key, key_length);
+		idx_t lower = 0;
+		idx_t upper = entry_count;
+		while (lower < upper) {
+			auto middle = lower + (upper - lower) / 2;
+			auto &entry = entries[middle];
+			auto cmp = Compare(entry, prefix, key, key_length);
+			if (cmp == 0) {
+				value = string_t(strings + entry.value_offset, entry.value_length);
+				return true;
+			}
+			if (cmp < 0) {
+				lower = middle + 1;
+			} else {
+				upper = middle;
+			}
+		}
+		return false;
+	}
+
+	bool Lookup(const string_t &key, string_t &value) const {
+		return Lookup(key.GetData(), key.GetSize(), value);
+	}
+
+private:
+	int Compare(const LookupTableEntry &entry, uint64_t prefix, const char *key, uint32_t key_length) const {
+		if (entry.prefix != prefix) {
+			return entry.prefix < prefix ? -1 : 1;
+		}
+		auto cmp = memcmp(strings + entry.key_offset, key, std::min(entry.key_length, key_length));
+		if (cmp != 0) {
+			return cmp;
+		}
+		return entry.key_length == key_length ? 0 : (entry.key_length < key_length ? -1 : 1);
+	}
+
+private:
+	MappedFile file;
+	const LookupTableEntry *entries;
+	idx_t entry_count;
+	const char *strings;
+};
+
+struct LookupOperator {
+	static ResultValue<string_t> Operation(const string_t &key, const LookupTable &table) {
+		string_t value;
+		if (!table.Lookup(key, value)) {
+			return nullptr;
+		}
+		return value;
+	}
+};
+
+//! name(key VARCHAR) -> VARCHAR: the value of the key in the table, or NULL. The table is shared by every connection
+//! and is unmapped once the function is dropped.
+class LookupFunction : public UnaryFunctionData<LookupOperator, PrimitiveType<string_t>, PrimitiveType<string_t>,
+                                                LookupTable> {
+public:
+	LookupFunction(std::string name_p, std::shared_ptr<LookupTable> table)
+	    : UnaryFunctionData(std::move(table)), name(std::move(name_p)) {
+	}
+
+	const char *Name() const override {
+		return name.c_str();
+	}
+
+private:
+	std::string name;
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/mapped_file.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+
+#include <string>
+
+#ifdef _WIN32
+// Without the min and max macros of <windows.h>. NOMINMAX is only defined for this include, it does not leak into
+// the code that includes this header.
+#ifndef NOMINMAX
+#define NOMINMAX
+#define DUCKDB_STABLE_DEFINED_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef DUCKDB_STABLE_DEFINED_NOMINMAX
+#undef NOMINMAX
+#undef DUCKDB_STABLE_DEFINED_NOMINMAX
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb_stable {
+
+//! A read-only memory mapping of a file. The pages are shared with every other process that maps the same file.
+class MappedFile {
+public:
+	explicit MappedFile(const std::string &path) : data(nullptr), size(0) {
+#ifdef _WIN32
+		auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                        FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw Exception("Could not open file \"" + path + "\"");
+		}
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size)) {
+			CloseHandle(file);
+			throw Exception("Could not get the size of file \"" + path + "\"");
+		}
+		size = static_cast<idx_t>(file_size.QuadPart);
+		if (size > 0) {
+			auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping) {
+				data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+#else
+		auto fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw Exception("Could not open file \"" + path + "\"");
+		}
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0) {
+			close(fd);
+			throw Exception("Could not get the size of file \"" + path + "\"");
+		}
+		size = static_cast<idx_t>(file_stat.st_size);
+		if (size > 0) {
+			auto mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+			data = mapping == MAP_FAILED ? nullptr : static_cast<const char *>(mapping);
+		}
+		close(fd);
+#endif
+		if (size > 0 && !data) {
+			throw Exception("Could not memory-map file \"" + path + "\"");
+		}
+	}
+	~MappedFile() {
+		if (!data) {
+			return;
+		}
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap(const_cast<char *>(data), size);
+#endif
+	}
+
+	//! Disable copy constructors.
+	MappedFile(const MappedFile &other) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	//! Enable move constructors.
+	MappedFile(MappedFile &&other) noexcept : data(nullptr), size(0) {
+		std::swap(data, other.data);
+		std::swap(size, other.size);
+	}
+	MappedFile &operator=(MappedFile &&other) noexcept {
+		std::swap(data, other.data);
+		std::swap(size, other.size);
+		return *this;
+	}
+
+public:
+	const char *Data() const {
+		return data;
+	}
+
+	idx_t Size() const {
+		return size;
+	}
+
+private:
+	const char *data;
+	idx_t size;
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,417 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/memo_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/fused_operator.hpp"
+#include "duckdb/stable/hash.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/string_type.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace duckdb_stable {
+
+struct MemoStatistics {
+	//! Rows answered from the cache.
+	uint64_t hits = 0;
+	//! Rows whose input equals the input of the previous row, answered without hashing.
+	uint64_t adjacent_hits = 0;
+	//! Rows for which the operator was invoked.
+	uint64_t misses = 0;
+	//! Entries that were replaced to make room for a new one.
+	uint64_t evictions = 0;
+
+	void Add(const MemoStatistics &other) {
+		hits += other.hits;
+		adjacent_hits += other.adjacent_hits;
+		misses += other.misses;
+		evictions += other.evictions;
+	}
+};
+
+//! An owned copy of an input or result of type T, which outlives the vector it came from.
+template <class T>
+struct MemoValue {
+	using STORAGE = T;
+
+	static void Store(STORAGE &storage, const T &value) {
+		storage = value;
+	}
+	static T Load(const STORAGE &storage) {
+		return storage;
+	}
+	//! Bitwise for floating point, so that -0.0 and 0.0 (or NaNs) are different inputs.
+	static bool Equals(const STORAGE &storage, const T &value) {
+		return std::is_floating_point<T>::value ? memcmp(&storage, &value, sizeof(T)) == 0 : storage == value;
+	}
+};
+
+template <>
+struct MemoValue<string_t> {
+	using STORAGE = std::string;
+
+	static void Store(STORAGE &storage, const string_t &value) {
+		storage.assign(value.GetData(), value.GetSize());
+	}
+	static string_t Load(const STORAGE &storage) {
+		return string_t(storage.data(), static_cast<uint32_t>(storage.size()));
+	}
+	static bool Equals(const STORAGE &storage, const string_t &value) {
+		return storage.size() == value.GetSize() && memcmp(storage.data(), value.GetData(), storage.size()) == 0;
+	}
+};
+
+template <class T>
+struct MemoResult {
+	typename MemoValue<T>::STORAGE val;
+	bool is_null = false;
+
+	void Store(const ResultValue<T> &result) {
+		is_null = result.is_null;
+		if (!is_null) {
+			MemoValue<T>::Store(val, result.val);
+		}
+	}
+	ResultValue<T> Load() const {
+		if (is_null) {
+			return nullptr;
+		}
+		return MemoValue<T>::Load(val);
+	}
+};
+
+//! The inputs of a row of a unary or binary operator.
+template <class... ARGS>
+struct MemoKey {};
+
+template <class A>
+struct MemoKey<A> {
+	typename MemoValue<A>::STORAGE a;
+
+	static uint64_t Hash(const A &a_val) {
+		return HashUtil::Hash(a_val);
+	}
+	bool Equals(const A &a_val) const {
+		return MemoValue<A>::Equals(a, a_val);
+	}
+	void Store(const A &a_val) {
+		MemoValue<A>::Store(a, a_val);
+	}
+};
+
+template <class A, class B>
+struct MemoKey<A, B> {
+	typename MemoValue<A>::STORAGE a;
+	typename MemoValue<B>::STORAGE b;
+
+	static uint64_t Hash(const A &a_val, const B &b_val) {
+		return HashUtil::CombineHash(HashUtil::Hash(a_val), HashUtil::Hash(b_val));
+	}
+	bool Equals(const A &a_val, const B &b_val) const {
+		return MemoValue<A>::Equals(a, a_val) && MemoValue<B>::Equals(b, b_val);
+	}
+	void Store(const A &a_val, const B &b_val) {
+		MemoValue<A>::Store(a, a_val);
+		MemoValue<B>::Store(b, b_val);
+	}
+};
+
+//! A bounded map from the inputs of an operator to its result, with CLOCK eviction: every hit sets the reference bit
+//! of the entry, and an insert into a full cache replaces the first entry the clock hand finds without it. Entries
+//! are found through a linear probing table over the entry indexes. Not thread-safe - every thread has its own.
+template <class KEY, class RESULT_T>
+class MemoCache {
+public:
+	struct Entry {
+		KEY key;
+		MemoResult<RESULT_T> result;
+		uint64_t hash;
+		bool referenced;
+	};
+
+	explicit MemoCache(idx_t capacity_p) : capacity(capacity_p), hand(0), previous(nullptr) {
+		if (capacity == 0 || capacity > std::numeric_limits<uint32_t>::max() / 2) {
+			throw Exception("Invalid memoization cache capacity " + std::to_string(capacity));
+		}
+		// Entries never move, so the previous entry stays valid until it is replaced.
+		entries.reserve(capacity);
+		idx_t table_size = 1;
+		while (table_size < capacity * 2) {
+			table_size *= 2;
+		}
+		table.resize(table_size, 0);
+		mask = table_size - 1;
+	}
+
+	//! Disable copy constructors.
+	MemoCache(const MemoCache &other) = delete;
+	MemoCache &operator=(const MemoCache &) = delete;
+
+public:
+	//! The entry that was found or inserted last, for runs of the same input.
+	Entry *Previous() const {
+		return previous;
+	}
+
+	template <class... ARGS>
+	Entry *Find(uint64_t hash, const ARGS &...args) {
+		for (auto slot = hash & mask; table[slot] != 0; slot = (slot + 1) & mask) {
+			auto &entry = entries[table[slot] - 1];
+			if (entry.hash == hash && entry.key.Equals(args...)) {
+				entry.referenced = true;
+				previous = &entry;
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	//! Adds the result for inputs that are not in the cache.
+	template <class... ARGS>
+	Entry &Insert(uint64_t hash, const ResultValue<RESULT_T> &result, MemoStatistics &statistics,
+	              const ARGS &...args) {
+		idx_t index;
+		if (entries.size() < capacity) {
+			index = entries.size();
+			entries.emplace_back();
+		} else {
+			while (entries[hand].referenced) {
+				entries[hand].referenced = false;
+				hand = (hand + 1) % capacity;
+			}
+			index = hand;
+			hand = (hand + 1) % capacity;
+			Remove(index);
+			statistics.evictions++;
+		}
+		auto &entry = entries[index];
+		entry.key.Store(args...);
+		entry.result.Store(result);
+		entry.hash = hash;
+		entry.referenced = false;
+		auto slot = hash & mask;
+		while (table[slot] != 0) {
+			slot = (slot + 1) & mask;
+		}
+		table[slot] = static_cast<uint32_t>(index + 1);
+		previous = &entry;
+		return entry;
+	}
+
+	idx_t Size() const {
+		return entries.size();
+	}
+
+private:
+	//! Removes the entry from the probing table, shifting later entries of its probe sequence back into the gap.
+	void Remove(idx_t index) {
+		auto slot = entries[index].hash & mask;
+		while (table[slot] != index + 1) {
+			slot = (slot + 1) & mask;
+		}
+		table[slot] = 0;
+		for (auto next = (slot + 1) & mask; table[next] != 0; next = (next + 1) & mask) {
+			auto home = entries[table[next] - 1].hash & mask;
+			// The entry can move into the gap unless its home lies cyclically in (slot, next].
+			bool stays = slot <= next ? (home > slot && home <= next) : (home > slot || home <= next);
+			if (!stays) {
+				table[slot] = table[next];
+				table[next] = 0;
+				slot = next;
+			}
+		}
+	}
+
+private:
+	idx_t capacity;
+	std::vector<Entry> entries;
+	//! The index + 1 of the entry in every slot, 0 for an empty slot.
+	std::vector<uint32_t> table;
+	uint64_t mask;
+	idx_t hand;
+	Entry *previous;
+};
+
+//! The counts of every thread that used a memoized operator, for Memoized::Statistics.
+class MemoStatisticsRegistry {
+public:
+	//! The counts of one thread. Only that thread writes them (without read-modify-write), others only read.
+	struct ThreadCounters {
+		std::atomic<uint64_t> hits {0};
+		std::atomic<uint64_t> adjacent_hits {0};
+		std::atomic<uint64_t> misses {0};
+		std::atomic<uint64_t> evictions {0};
+
+		void Add(const MemoStatistics &statistics) {
+			Add(hits, statistics.hits);
+			Add(adjacent_hits, statistics.adjacent_hits);
+			Add(misses, statistics.misses);
+			Add(evictions, statistics.evictions);
+		}
+		MemoStatistics Load() const {
+			MemoStatistics result;
+			result.hits = hits.load(std::memory_order_relaxed);
+			result.adjacent_hits = adjacent_hits.load(std::memory_order_relaxed);
+			result.misses = misses.load(std::memory_order_relaxed);
+			result.evictions = evictions.load(std::memory_order_relaxed);
+			return result;
+		}
+
+	private:
+		static void Add(std::atomic<uint64_t> &counter, uint64_t count) {
+			counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		}
+	};
+
+	void Register(ThreadCounters &counters) {
+		std::lock_guard<std::mutex> guard(lock);
+		threads.push_back(&counters);
+	}
+
+	//! Keeps the counts of a thread that exits.
+	void Unregister(ThreadCounters &counters) {
+		std::lock_guard<std::mutex> guard(lock);
+		exited.Add(counters.Load());
+		for (idx_t i = 0; i < threads.size(); i++) {
+			if (threads[i] == &counters) {
+				threads.erase(threads.begin() + static_cast<std::ptrdiff_t>(i));
+				break;
+			}
+		}
+	}
+
+	MemoStatistics Statistics() {
+		std::lock_guard<std::mutex> guard(lock);
+		auto result = exited;
+		for (auto counters : threads) {
+			result.Add(counters->Load());
+		}
+		return result;
+	}
+
+private:
+	std::mutex lock;
+	std::vector<ThreadCounters *> threads;
+	MemoStatistics exited;
+};
+
+//! Wraps a CONSISTENT operator over ARGS (the ARG_TYPEs of its one or two inputs) with a cache of its last CAPACITY
+//! distinct results per thread, for expensive operators over repetitive inputs (parsing, lookups). A row whose input
+//! equals the previous row's is answered without hashing, other rows with one hash and a probe. Strings are keyed by
+//! their bytes, the cache owns copies of inputs and results.
+//!
+//! The cache is found once per chunk through STATIC_DATA (so use it through UnaryFunctionExt/BinaryFunctionExt or
+//! the MemoizedXxxFunction classes), and the row path takes no locks. Hit and miss counts are published per chunk,
+//! see Statistics(). Operators that throw are not cached.
+template <class OP, idx_t CAPACITY, class... ARGS>
+struct Memoized {
+	static_assert(OperatorStability<OP>::value == FunctionStability::CONSISTENT,
+	              "Only CONSISTENT operators can be memoized");
+	static_assert(OperatorNullHandling<OP>::value == FunctionNullHandling::DEFAULT_NULL_HANDLING,
+	              "Operators that handle NULLs themselves cannot be memoized");
+
+	using RESULT = typename FusedStepResult<OP, ARGS...>::type;
+	using KEY = MemoKey<ARGS...>;
+	using CACHE = MemoCache<KEY, RESULT>;
+
+	struct ThreadState {
+		ThreadState() : cache(CAPACITY) {
+			Registry().Register(counters);
+		}
+		~ThreadState() {
+			Registry().Unregister(counters);
+		}
+
+		CACHE cache;
+		MemoStatisticsRegistry::ThreadCounters counters;
+	};
+
+	//! The cache of the executing thread and the counts of the chunk, published when the chunk is done.
+	struct STATIC_DATA {
+		STATIC_DATA() : state(GetThreadState()) {
+		}
+		~STATIC_DATA() {
+			state.counters.Add(statistics);
+		}
+
+		//! Disable copy constructors.
+		STATIC_DATA(const STATIC_DATA &other) = delete;
+		STATIC_DATA &operator=(const STATIC_DATA &) = delete;
+
+		ThreadState &state;
+		MemoStatistics statistics;
+		typename FusedStep<OP>::DATA op_data;
+	};
+
+	static ResultValue<RESULT> Operation(const ARGS &...args, STATIC_DATA &data) {
+		auto &cache = data.state.cache;
+		auto previous = cache.Previous();
+		if (previous && previous->key.Equals(args...)) {
+			data.statistics.adjacent_hits++;
+			previous->referenced = true;
+			return previous->result.Load();
+		}
+		auto hash = KEY::Hash(args...);
+		auto entry = cache.Find(hash, args...);
+		if (entry) {
+			data.statistics.hits++;
+			return entry->result.Load();
+		}
+		data.statistics.misses++;
+		ResultValue<RESULT> result = FusedStep<OP>::Call(data.op_data, args...);
+		cache.Insert(hash, result, data.statistics, args...);
+		return result;
+	}
+
+	//! The counts of all threads since the process started.
+	static MemoStatistics Statistics() {
+		return Registry().Statistics();
+	}
+
+private:
+	static MemoStatisticsRegistry &Registry() {
+		static MemoStatisticsRegistry registry;
+		return registry;
+	}
+
+	static ThreadState &GetThreadState() {
+		static thread_local ThreadState state;
+		return state;
+	}
+};
+
+//! name(INPUT) -> RESULT with OP memoized per thread, see Memoized.
+template <class OP, class INPUT_TYPE_T, class RETURN_TYPE_T, idx_t CAPACITY = 4096>
+class MemoizedUnaryFunction
+    : public UnaryFunctionExt<Memoized<OP, CAPACITY, typename INPUT_TYPE_T::ARG_TYPE>, INPUT_TYPE_T, RETURN_TYPE_T,
+                              typename Memoized<OP, CAPACITY, typename INPUT_TYPE_T::ARG_TYPE>::STATIC_DATA> {
+public:
+	using MEMOIZED = Memoized<OP, CAPACITY, typename INPUT_TYPE_T::ARG_TYPE>;
+};
+
+//! name(A, B) -> RESULT with OP memoized per thread, see Memoized.
+template <class OP, class A_TYPE_T, class B_TYPE_T, class RETURN_TYPE_T, idx_t CAPACITY = 4096>
+class MemoizedBinaryFunction
+    : public BinaryFunctionExt<
+          Memoized<OP, CAPACITY, typename A_TYPE_T::ARG_TYPE, typename B_TYPE_T::ARG_TYPE>, A_TYPE_T, B_TYPE_T,
+          RETURN_TYPE_T,
+          typename Memoized<OP, CAPACITY, typename A_TYPE_T::ARG_TYPE, typename B_TYPE_T::ARG_TYPE>::STATIC_DATA> {
+public:
+	using MEMOIZED = Memoized<OP, CAPACITY, typename A_TYPE_T::ARG_TYPE, typename B_TYPE_T::ARG_TYPE>;
+};
+
+} // namespace duckdb_stable
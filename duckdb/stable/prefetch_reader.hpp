@@ -0,0 +1,416 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/prefetch_reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/allocator.hpp"
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+// Without the min and max macros of <windows.h>. NOMINMAX is only defined for this include, it does not leak into
+// the code that includes this header.
+#ifndef NOMINMAX
+#define NOMINMAX
+#define DUCKDB_STABLE_DEFINED_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef DUCKDB_STABLE_DEFINED_NOMINMAX
+#undef NOMINMAX
+#undef DUCKDB_STABLE_DEFINED_NOMINMAX
+#endif
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb_stable {
+
+//! A file opened for positional reads, which can be issued from any thread.
+class ReadFileHandle {
+public:
+	explicit ReadFileHandle(const std::string &path_p) : path(path_p), size(0) {
+#ifdef _WIN32
+		handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (handle == INVALID_HANDLE_VALUE) {
+			throw Exception("Could not open file \"" + path + "\"");
+		}
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(handle, &file_size)) {
+			CloseHandle(handle);
+			throw Exception("Could not get the size of file \"" + path + "\"");
+		}
+		size = static_cast<idx_t>(file_size.QuadPart);
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw Exception("Could not open file \"" + path + "\"");
+		}
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0) {
+			close(fd);
+			throw Exception("Could not get the size of file \"" + path + "\"");
+		}
+		size = static_cast<idx_t>(file_stat.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+		// Only a hint: a larger kernel read-ahead window for the sequential scan.
+		posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+	}
+	~ReadFileHandle() {
+#ifdef _WIN32
+		if (handle != INVALID_HANDLE_VALUE) {
+			CloseHandle(handle);
+		}
+#else
+		if (fd >= 0) {
+			close(fd);
+		}
+#endif
+	}
+
+	//! Disable copy constructors.
+	ReadFileHandle(const ReadFileHandle &other) = delete;
+	ReadFileHandle &operator=(const ReadFileHandle &) = delete;
+
+	//! Enable move constructors.
+#ifdef _WIN32
+	ReadFileHandle(ReadFileHandle &&other) noexcept : handle(INVALID_HANDLE_VALUE), size(0) {
+		std::swap(path, other.path);
+		std::swap(handle, other.handle);
+		std::swap(size, other.size);
+	}
+	ReadFileHandle &operator=(ReadFileHandle &&other) noexcept {
+		std::swap(path, other.path);
+		std::swap(handle, other.handle);
+		std::swap(size, other.size);
+		return *this;
+	}
+#else
+	ReadFileHandle(ReadFileHandle &&other) noexcept : fd(-1), size(0) {
+		std::swap(path, other.path);
+		std::swap(fd, other.fd);
+		std::swap(size, other.size);
+	}
+	ReadFileHandle &operator=(ReadFileHandle &&other) noexcept {
+		std::swap(path, other.path);
+		std::swap(fd, other.fd);
+		std::swap(size, other.size);
+		return *this;
+	}
+#endif
+
+public:
+	const std::string &GetPath() const {
+		return path;
+	}
+
+	idx_t Size() const {
+		return size;
+	}
+
+	//! Reads exactly "length" bytes at "offset", the range must lie within the file.
+	void ReadAt(char *buffer, idx_t length, idx_t offset) const {
+		while (length > 0) {
+#ifdef _WIN32
+			OVERLAPPED overlapped = {};
+			overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+			overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+			DWORD bytes_read = 0;
+			auto request = static_cast<DWORD>(std::min<idx_t>(length, 1 << 30));
+			if (!ReadFile(handle, buffer, request, &bytes_read, &overlapped)) {
+				throw Exception("Could not read from file \"" + path + "\"");
+			}
+			auto result = static_cast<idx_t>(bytes_read);
+#else
+			auto bytes_read = pread(fd, buffer, length, static_cast<off_t>(offset));
+			if (bytes_read < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				throw Exception("Could not read from file \"" + path + "\"");
+			}
+			auto result = static_cast<idx_t>(bytes_read);
+#endif
+			if (result == 0) {
+				throw Exception("Unexpected end of file \"" + path + "\"");
+			}
+			buffer += result;
+			offset += result;
+			length -= result;
+		}
+	}
+
+private:
+	std::string path;
+#ifdef _WIN32
+	HANDLE handle;
+#else
+	int fd;
+#endif
+	idx_t size;
+};
+
+struct PrefetchOptions {
+	//! The bytes per buffer. Buffers start at multiples of this size, so for fixed-width records a multiple of the
+	//! record size keeps records from spanning buffers.
+	idx_t buffer_size = 1 << 20;
+	//! The number of buffers, which bounds both the memory use and how far the reads run ahead of the scan.
+	idx_t buffer_count = 8;
+};
+
+//! Reads files front to back on a background thread, ahead of the scan. The thread fills a fixed set of buffers
+//! with positional reads and queues them in file order; scan threads take filled buffers with Next(), decode them,
+//! and hand them back with their next call to Next(). This overlaps the I/O of the next buffers with the decoding of
+//! the current ones, instead of stalling a DuckDB worker thread on every read.
+//!
+//! The reader is typically created in the global state of a table function, with one handle per local state.
+class PrefetchReader {
+private:
+	struct Slot {
+		char *data;
+		idx_t size;
+		idx_t offset;
+		idx_t file_index;
+	};
+
+public:
+	//! A filled buffer. It must be released (destroyed or reset) before the reader is destroyed.
+	class Buffer {
+	public:
+		Buffer() : reader(nullptr), slot(nullptr) {
+		}
+		~Buffer() {
+			Reset();
+		}
+
+		//! Disable copy constructors.
+		Buffer(const Buffer &other) = delete;
+		Buffer &operator=(const Buffer &) = delete;
+
+		//! Enable move constructors.
+		Buffer(Buffer &&other) noexcept : reader(nullptr), slot(nullptr) {
+			std::swap(reader, other.reader);
+			std::swap(slot, other.slot);
+		}
+		Buffer &operator=(Buffer &&other) noexcept {
+			std::swap(reader, other.reader);
+			std::swap(slot, other.slot);
+			return *this;
+		}
+
+	public:
+		//! False for the empty buffer that signals the end of the files.
+		explicit operator bool() const {
+			return slot != nullptr;
+		}
+
+		const char *Data() const {
+			return slot->data;
+		}
+		idx_t Size() const {
+			return slot->size;
+		}
+		//! The position of the buffer in its file.
+		idx_t Offset() const {
+			return slot->offset;
+		}
+		idx_t FileIndex() const {
+			return slot->file_index;
+		}
+
+		//! Hand the buffer back to the reader, so it can be filled again.
+		void Reset() {
+			if (slot) {
+				reader->Release(slot);
+				reader = nullptr;
+				slot = nullptr;
+			}
+		}
+
+	private:
+		friend class PrefetchReader;
+		Buffer(PrefetchReader *reader_p, Slot *slot_p) : reader(reader_p), slot(slot_p) {
+		}
+
+		PrefetchReader *reader;
+		Slot *slot;
+	};
+
+public:
+	//! Opens all files up front - missing files are reported here, before the scan starts.
+	explicit PrefetchReader(const std::vector<std::string> &paths, PrefetchOptions options_p = PrefetchOptions())
+	    : options(options_p), finished(false), stopped(false) {
+		if (options.buffer_size == 0 || options.buffer_count == 0) {
+			throw Exception("PrefetchReader requires a buffer size and buffer count of at least 1");
+		}
+		for (auto &path : paths) {
+			files.emplace_back(path);
+		}
+		slots.resize(options.buffer_count);
+		try {
+			for (auto &slot : slots) {
+				slot.data = static_cast<char *>(DuckDBMemory::Allocate(options.buffer_size));
+				free_slots.push_back(&slot);
+			}
+		} catch (...) {
+			FreeBuffers();
+			throw;
+		}
+		thread = std::thread([this]() { Run(); });
+	}
+	explicit PrefetchReader(const std::string &path, PrefetchOptions options_p = PrefetchOptions())
+	    : PrefetchReader(std::vector<std::string>(1, path), options_p) {
+	}
+	~PrefetchReader() {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stopped = true;
+		}
+		slot_freed.notify_all();
+		thread.join();
+		FreeBuffers();
+	}
+
+	//! Disable copy constructors.
+	PrefetchReader(const PrefetchReader &other) = delete;
+	PrefetchReader &operator=(const PrefetchReader &) = delete;
+
+public:
+	//! Releases "buffer", then waits for the next filled buffer in file order and moves it into "buffer". Returns false
+	//! once all files have been read. Safe to call from multiple threads, every buffer goes to exactly one caller.
+	//! Read errors are thrown once the buffers that were read before the error have been handed out.
+	bool Next(Buffer &buffer) {
+		// Release first: a caller that waits while holding a buffer could otherwise hold up the reader forever.
+		buffer.Reset();
+		std::unique_lock<std::mutex> guard(lock);
+		slot_filled.wait(guard, [this]() { return !filled_slots.empty() || finished; });
+		if (!filled_slots.empty()) {
+			buffer = Buffer(this, filled_slots.front());
+			filled_slots.pop_front();
+			return true;
+		}
+		if (!error.empty()) {
+			throw Exception(error);
+		}
+		return false;
+	}
+
+	idx_t FileCount() const {
+		return files.size();
+	}
+
+	const ReadFileHandle &GetFile(idx_t file_index) const {
+		return files[file_index];
+	}
+
+	//! The total size of all files in bytes.
+	idx_t TotalSize() const {
+		idx_t result = 0;
+		for (auto &file : files) {
+			result += file.Size();
+		}
+		return result;
+	}
+
+	const PrefetchOptions &GetOptions() const {
+		return options;
+	}
+
+private:
+	void Run() {
+		for (idx_t file_index = 0; file_index < files.size(); file_index++) {
+			auto &file = files[file_index];
+			for (idx_t offset = 0; offset < file.Size(); offset += options.buffer_size) {
+				Slot *slot;
+				{
+					std::unique_lock<std::mutex> guard(lock);
+					slot_freed.wait(guard, [this]() { return !free_slots.empty() || stopped; });
+					if (stopped) {
+						return;
+					}
+					slot = free_slots.back();
+					free_slots.pop_back();
+				}
+				slot->size = std::min<idx_t>(options.buffer_size, file.Size() - offset);
+				slot->offset = offset;
+				slot->file_index = file_index;
+				try {
+					// Read without holding the lock, the scan threads keep taking buffers in the meantime.
+					file.ReadAt(slot->data, slot->size, offset);
+				} catch (std::exception &ex) {
+					std::lock_guard<std::mutex> guard(lock);
+					free_slots.push_back(slot);
+					error = ex.what();
+					finished = true;
+					slot_filled.notify_all();
+					return;
+				}
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					filled_slots.push_back(slot);
+				}
+				slot_filled.notify_one();
+			}
+		}
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			finished = true;
+		}
+		slot_filled.notify_all();
+	}
+
+	void Release(Slot *slot) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			free_slots.push_back(slot);
+		}
+		slot_freed.notify_one();
+	}
+
+	void FreeBuffers() {
+		for (auto &slot : slots) {
+			if (slot.data) {
+				DuckDBMemory::Free(slot.data);
+				slot.data = nullptr;
+			}
+		}
+	}
+
+private:
+	PrefetchOptions options;
+	std::vector<ReadFileHandle> files;
+	std::vector<Slot> slots;
+
+	std::mutex lock;
+	//! Signalled when a buffer is queued or the reader is finished.
+	std::condition_variable slot_filled;
+	//! Signalled when a buffer is released or the reader is stopped.
+	std::condition_variable slot_freed;
+	std::vector<Slot *> free_slots;
+	std::deque<Slot *> filled_slots;
+	bool finished;
+	bool stopped;
+	std::string error;
+
+	std::thread thread;
+};
+
+} // namespace duckdb_stable
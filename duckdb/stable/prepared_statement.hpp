@@ -0,0 +1,263 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/prepared_statement.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/hugeint.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/query_result.hpp"
+#include "duckdb/stable/string_type.hpp"
+#include "duckdb/stable/uhugeint.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace duckdb_stable {
+
+//! Binds a C++ value to a (1-based) prepared statement parameter with the matching duckdb_bind_* function.
+struct ParameterBinder {
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, bool val) {
+		return duckdb_bind_boolean(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, int8_t val) {
+		return duckdb_bind_int8(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, int16_t val) {
+		return duckdb_bind_int16(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, int32_t val) {
+		return duckdb_bind_int32(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, int64_t val) {
+		return duckdb_bind_int64(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, uint8_t val) {
+		return duckdb_bind_uint8(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, uint16_t val) {
+		return duckdb_bind_uint16(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, uint32_t val) {
+		return duckdb_bind_uint32(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, uint64_t val) {
+		return duckdb_bind_uint64(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, float val) {
+		return duckdb_bind_float(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, double val) {
+		return duckdb_bind_double(s, i, val);
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, hugeint_t val) {
+		return duckdb_bind_hugeint(s, i, val.c_hugeint());
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, uhugeint_t val) {
+		return duckdb_bind_uhugeint(s, i, val.c_uhugeint());
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, string_t val) {
+		return duckdb_bind_varchar_length(s, i, val.GetData(), val.GetSize());
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, const char *val) {
+		return duckdb_bind_varchar_length(s, i, val, strlen(val));
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, const std::string &val) {
+		return duckdb_bind_varchar_length(s, i, val.c_str(), val.size());
+	}
+	static duckdb_state Bind(duckdb_prepared_statement s, idx_t i, std::nullptr_t) {
+		return duckdb_bind_null(s, i);
+	}
+};
+
+//! An owning wrapper around a duckdb_prepared_statement. The statement is planned once by duckdb_prepare and can then
+//! be bound and executed any number of times.
+class PreparedStatement {
+public:
+	PreparedStatement(duckdb_connection connection, const char *query) : statement(nullptr) {
+		if (duckdb_prepare(connection, query, &statement) != DuckDBSuccess) {
+			std::string error = duckdb_prepare_error(statement);
+			duckdb_destroy_prepare(&statement);
+			throw Exception("Failed to prepare query: " + error);
+		}
+	}
+	~PreparedStatement() {
+		if (statement) {
+			duckdb_destroy_prepare(&statement);
+		}
+	}
+
+	//! Disable copy constructors.
+	PreparedStatement(const PreparedStatement &other) = delete;
+	PreparedStatement &operator=(const PreparedStatement &) = delete;
+
+	//! Enable move constructors.
+	PreparedStatement(PreparedStatement &&other) noexcept : statement(nullptr) {
+		std::swap(statement, other.statement);
+	}
+	PreparedStatement &operator=(PreparedStatement &&other) noexcept {
+		std::swap(statement, other.statement);
+		return *this;
+	}
+
+public:
+	//! Bind a value through its executor type, e.g. Bind<PrimitiveType<int32_t>>(1, 42). Throws unless the parameter
+	//! takes values of TYPE: one stored like TYPE (see TypeMatchesLogicalType), any number for a numeric parameter
+	//! (DuckDB casts it), or anything for a parameter whose type DuckDB could not infer.
+	template <class TYPE>
+	void Bind(const idx_t param_idx, const typename TYPE::ARG_TYPE &val) {
+		VerifyParameterType<TYPE>(param_idx);
+		BindValue(param_idx, val);
+	}
+
+	//! Bind a value by its C++ type, parameters are 1-based.
+	template <class T>
+	void BindValue(const idx_t param_idx, const T &val) {
+		if (ParameterBinder::Bind(statement, param_idx, val) != DuckDBSuccess) {
+			throw Exception(Exception::ConstructMessage("Failed to bind parameter {}: {}", param_idx,
+			                                            std::string(duckdb_prepare_error(statement))));
+		}
+	}
+
+	//! Bind all parameters (in order) in one call.
+	template <typename... ARGS>
+	void BindAll(const ARGS &...args) {
+		BindRecursive(1, args...);
+	}
+
+	idx_t ParameterCount() {
+		return duckdb_nparams(statement);
+	}
+
+	void ClearBindings() {
+		duckdb_clear_bindings(statement);
+	}
+
+	//! Execute the statement with the currently bound parameters, without re-planning it.
+	QueryResult Execute() {
+		duckdb_result result;
+		if (duckdb_execute_prepared(statement, &result) != DuckDBSuccess) {
+			std::string error = duckdb_result_error(&result);
+			duckdb_destroy_result(&result);
+			throw Exception("Failed to execute prepared statement: " + error);
+		}
+		return QueryResult(result);
+	}
+
+	//! Bind all parameters and execute the statement.
+	template <typename... ARGS>
+	QueryResult Execute(const ARGS &...args) {
+		BindAll(args...);
+		return Execute();
+	}
+
+	//! Execute the statement with a streaming result.
+	QueryResult Stream() {
+		return QueryResult::Stream(statement);
+	}
+
+public:
+	duckdb_prepared_statement c_prepared_statement() {
+		return statement;
+	}
+
+private:
+	void BindRecursive(idx_t) {
+	}
+
+	template <class T, typename... ARGS>
+	void BindRecursive(idx_t param_idx, const T &val, const ARGS &...args) {
+		BindValue(param_idx, val);
+		BindRecursive(param_idx + 1, args...);
+	}
+
+	template <class TYPE>
+	void VerifyParameterType(const idx_t param_idx) {
+		LogicalType param_type(duckdb_param_logical_type(statement, param_idx));
+		if (!param_type.c_logical_type()) {
+			// Out of range - reported by the bind itself.
+			return;
+		}
+		auto param_id = duckdb_get_type_id(param_type.c_logical_type());
+		if (param_id == DUCKDB_TYPE_INVALID || param_id == DUCKDB_TYPE_ANY || param_id == DUCKDB_TYPE_SQLNULL) {
+			return;
+		}
+		if (TypeMatchesLogicalType<TYPE>::Matches(param_type.c_logical_type())) {
+			return;
+		}
+		auto value_id = duckdb_get_type_id(TemplateToType::Intern<TYPE>().c_logical_type());
+		if (IsNumeric(param_id) && IsNumeric(value_id)) {
+			return;
+		}
+		throw Exception(Exception::ConstructMessage("Failed to bind parameter {}: a {} parameter does not take {} "
+		                                            "values",
+		                                            param_idx, TypeIdToString(param_id), TypeIdToString(value_id)));
+	}
+
+	static bool IsNumeric(duckdb_type id) {
+		switch (id) {
+		case DUCKDB_TYPE_TINYINT:
+		case DUCKDB_TYPE_SMALLINT:
+		case DUCKDB_TYPE_INTEGER:
+		case DUCKDB_TYPE_BIGINT:
+		case DUCKDB_TYPE_UTINYINT:
+		case DUCKDB_TYPE_USMALLINT:
+		case DUCKDB_TYPE_UINTEGER:
+		case DUCKDB_TYPE_UBIGINT:
+		case DUCKDB_TYPE_HUGEINT:
+		case DUCKDB_TYPE_UHUGEINT:
+		case DUCKDB_TYPE_FLOAT:
+		case DUCKDB_TYPE_DOUBLE:
+		case DUCKDB_TYPE_DECIMAL:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+private:
+	duckdb_prepared_statement statement;
+};
+
+//! Caches the prepared statements of a single connection by their query text, so statements that are executed
+//! repeatedly are only prepared (and planned) once.
+class PreparedStatementCache {
+public:
+	explicit PreparedStatementCache(duckdb_connection connection_p) : connection(connection_p) {
+	}
+
+public:
+	PreparedStatement &Get(const std::string &query) {
+		auto entry = statements.find(query);
+		if (entry != statements.end()) {
+			return *entry->second;
+		}
+		auto statement = std::unique_ptr<PreparedStatement>(new PreparedStatement(connection, query.c_str()));
+		auto &result = *statement;
+		statements.emplace(query, std::move(statement));
+		return result;
+	}
+
+	idx_t Size() const {
+		return statements.size();
+	}
+
+	void Clear() {
+		statements.clear();
+	}
+
+private:
+	duckdb_connection connection;
+	std::unordered_map<std::string, std::unique_ptr<PreparedStatement>> statements;
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,262 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/query_result.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/data_chunk.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/executor.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/validity_mask.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <string>
+
+namespace duckdb_stable {
+
+//! Typed access to one column of a chunk, using the same executor types (and states) as the function executors.
+template <class TYPE>
+class ColumnReader {
+public:
+	using ARG_TYPE = typename TYPE::ARG_TYPE;
+
+	ColumnReader(DataChunk &chunk, const idx_t column_idx) : count(chunk.Size()) {
+		auto vector = chunk.GetVector(column_idx);
+		state.PrepareVector(vector, count);
+	}
+
+	class iterator { // NOLINT: match the standard iterator naming.
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = ResultValue<ARG_TYPE>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = value_type *;
+		using reference = value_type;
+
+		iterator(ColumnReader &reader_p, idx_t row_p) : reader(reader_p), row(row_p) {
+		}
+
+		ResultValue<ARG_TYPE> operator*() const {
+			return reader[row];
+		}
+		iterator &operator++() {
+			row++;
+			return *this;
+		}
+		bool operator!=(const iterator &other) const {
+			return row != other.row;
+		}
+		bool operator==(const iterator &other) const {
+			return row == other.row;
+		}
+
+	private:
+		ColumnReader &reader;
+		idx_t row;
+	};
+
+public:
+	idx_t Size() const {
+		return count;
+	}
+
+	bool IsValid(const idx_t row) const {
+		return ValidityMask(state.validity).RowIsValid(row);
+	}
+
+	//! Read a value without checking the validity of the row.
+	ARG_TYPE GetValue(const idx_t row) {
+		ARG_TYPE result;
+		TYPE::ConstructType(state, row, result);
+		return result;
+	}
+
+	ResultValue<ARG_TYPE> operator[](const idx_t row) {
+		if (!IsValid(row)) {
+			return nullptr;
+		}
+		return GetValue(row);
+	}
+
+	iterator begin() { // NOLINT: match the standard iterator naming.
+		return iterator(*this, 0);
+	}
+	iterator end() { // NOLINT: match the standard iterator naming.
+		return iterator(*this, count);
+	}
+
+private:
+	typename TYPE::STRUCT_STATE state;
+	idx_t count;
+};
+
+//! An owning wrapper around a duckdb_result that is consumed chunk by chunk with duckdb_fetch_chunk.
+//! Iterating the result yields every chunk exactly once - a chunk is destroyed when the iterator advances, so only a
+//! single chunk is alive at any time. Results created with Stream() are also produced incrementally by DuckDB.
+class QueryResult {
+public:
+	explicit QueryResult(duckdb_result result_p) : result(result_p), owning(true) {
+	}
+	~QueryResult() {
+		if (owning) {
+			duckdb_destroy_result(&result);
+		}
+	}
+
+	//! Disable copy constructors.
+	QueryResult(const QueryResult &other) = delete;
+	QueryResult &operator=(const QueryResult &) = delete;
+
+	//! Enable move constructors.
+	QueryResult(QueryResult &&other) noexcept : owning(false) {
+		memset(&result, 0, sizeof(result));
+		std::swap(result, other.result);
+		std::swap(owning, other.owning);
+	}
+	QueryResult &operator=(QueryResult &&other) noexcept {
+		std::swap(result, other.result);
+		std::swap(owning, other.owning);
+		return *this;
+	}
+
+	//! Run a query and return its (materialized) result.
+	static QueryResult Query(duckdb_connection connection, const char *query) {
+		duckdb_result result;
+		if (duckdb_query(connection, query, &result) != DuckDBSuccess) {
+			std::string error = duckdb_result_error(&result);
+			duckdb_destroy_result(&result);
+			throw Exception("Failed to run query: " + error);
+		}
+		return QueryResult(result);
+	}
+
+	//! Run a query with a streaming result, chunks are computed as they are fetched.
+	static QueryResult Stream(duckdb_connection connection, const char *query) {
+		duckdb_prepared_statement statement;
+		if (duckdb_prepare(connection, query, &statement) != DuckDBSuccess) {
+			std::string error = duckdb_prepare_error(statement);
+			duckdb_destroy_prepare(&statement);
+			throw Exception("Failed to prepare query: " + error);
+		}
+		auto result = Stream(statement);
+		duckdb_destroy_prepare(&statement);
+		return result;
+	}
+
+	//! Execute a prepared statement with a streaming result, chunks are computed as they are fetched.
+	static QueryResult Stream(duckdb_prepared_statement statement) {
+		duckdb_pending_result pending;
+		if (duckdb_pending_prepared_streaming(statement, &pending) != DuckDBSuccess) {
+			std::string error = duckdb_pending_error(pending);
+			duckdb_destroy_pending(&pending);
+			throw Exception("Failed to execute query: " + error);
+		}
+		duckdb_result result;
+		auto success = duckdb_execute_pending(pending, &result) == DuckDBSuccess;
+		duckdb_destroy_pending(&pending);
+		if (!success) {
+			std::string error = duckdb_result_error(&result);
+			duckdb_destroy_result(&result);
+			throw Exception("Failed to execute query: " + error);
+		}
+		return QueryResult(result);
+	}
+
+	class iterator { // NOLINT: match the standard iterator naming.
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = DataChunk;
+		using difference_type = std::ptrdiff_t;
+		using pointer = DataChunk *;
+		using reference = DataChunk &;
+
+		explicit iterator(QueryResult *result_p) : result(result_p), chunk(nullptr) {
+			Next();
+		}
+
+		DataChunk &operator*() {
+			return chunk;
+		}
+		DataChunk *operator->() {
+			return &chunk;
+		}
+		iterator &operator++() {
+			Next();
+			return *this;
+		}
+		bool operator!=(const iterator &other) const {
+			return result != other.result;
+		}
+		bool operator==(const iterator &other) const {
+			return result == other.result;
+		}
+
+	private:
+		void Next() {
+			if (!result) {
+				return;
+			}
+			chunk = result->Fetch();
+			if (!chunk.c_data_chunk()) {
+				// Exhausted: become equal to end().
+				result = nullptr;
+			}
+		}
+
+	private:
+		QueryResult *result;
+		DataChunk chunk;
+	};
+
+public:
+	//! Fetch the next chunk, returns a chunk wrapping nullptr once the result is exhausted. Throws if computing the
+	//! chunk failed, which streaming results only find out while they are fetched.
+	DataChunk Fetch() {
+		DataChunk chunk(duckdb_fetch_chunk(result), true);
+		if (!chunk.c_data_chunk()) {
+			auto error = duckdb_result_error(&result);
+			if (error) {
+				throw Exception(std::string("Failed to fetch query result: ") + error);
+			}
+		}
+		return chunk;
+	}
+
+	idx_t ColumnCount() {
+		return duckdb_column_count(&result);
+	}
+
+	const char *ColumnName(const idx_t column_idx) {
+		return duckdb_column_name(&result, column_idx);
+	}
+
+	LogicalType ColumnType(const idx_t column_idx) {
+		return LogicalType(duckdb_column_logical_type(&result, column_idx));
+	}
+
+	iterator begin() { // NOLINT: match the standard iterator naming.
+		return iterator(this);
+	}
+	iterator end() { // NOLINT: match the standard iterator naming.
+		return iterator(nullptr);
+	}
+
+public:
+	duckdb_result &c_result() {
+		return result;
+	}
+
+private:
+	duckdb_result result;
+	bool owning;
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,214 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/registration_builder.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/cast_function.hpp"
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/table_function.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace duckdb_stable {
+
+struct RegistrationPhase {
+	const char *name;
+	//! The number of objects (types, functions, sets) handled in this phase.
+	idx_t count;
+	uint64_t nanoseconds;
+};
+
+class RegistrationStatistics {
+public:
+	const std::vector<RegistrationPhase> &Phases() const {
+		return phases;
+	}
+
+	uint64_t TotalNanoseconds() const {
+		uint64_t result = 0;
+		for (auto &phase : phases) {
+			result += phase.nanoseconds;
+		}
+		return result;
+	}
+
+	std::string ToString() const {
+		std::string result;
+		for (auto &phase : phases) {
+			result += std::string(phase.name) + ": " + std::to_string(phase.count) + " in " +
+			          std::to_string(phase.nanoseconds / 1000) + "us\n";
+		}
+		result += "total: " + std::to_string(TotalNanoseconds() / 1000) + "us";
+		return result;
+	}
+
+private:
+	friend class RegistrationBuilder;
+
+	std::vector<RegistrationPhase> phases;
+};
+
+//! Collects the types and functions of an extension and registers them in one pass. Scalar functions that share a
+//! name are registered as a single function set, and the time spent in each phase is recorded. Functions that are
+//! added by reference must stay alive until Register is called.
+class RegistrationBuilder {
+public:
+	RegistrationBuilder() = default;
+
+	//! Disable copy constructors.
+	RegistrationBuilder(const RegistrationBuilder &other) = delete;
+	RegistrationBuilder &operator=(const RegistrationBuilder &) = delete;
+
+public:
+	RegistrationBuilder &AddType(LogicalType &type) {
+		types.push_back(&type);
+		return *this;
+	}
+
+	RegistrationBuilder &AddFunction(ScalarFunction &function) {
+		return AddFunction(function.Name(), function);
+	}
+
+	//! Add an (unnamed) overload to the set with the given name.
+	RegistrationBuilder &AddFunction(const char *name, ScalarFunction &function) {
+		auto entry = scalar_function_sets.find(name);
+		if (entry == scalar_function_sets.end()) {
+			entry = scalar_function_sets.emplace(name, scalar_functions.size()).first;
+			scalar_functions.push_back(ScalarFunctionGroup {name, std::vector<ScalarFunction *>()});
+		}
+		scalar_functions[entry->second].functions.push_back(&function);
+		scalar_function_count++;
+		return *this;
+	}
+
+	//! Construct a function that is owned by the builder.
+	template <class FUNCTION>
+	RegistrationBuilder &AddFunction() {
+		auto function = new FUNCTION();
+		owned_functions.emplace_back(function);
+		return AddFunction(*function);
+	}
+
+	template <class FUNCTION>
+	RegistrationBuilder &AddFunction(const char *name) {
+		auto function = new FUNCTION();
+		owned_functions.emplace_back(function);
+		return AddFunction(name, *function);
+	}
+
+	RegistrationBuilder &AddCast(CastFunction &cast) {
+		casts.push_back(&cast);
+		return *this;
+	}
+
+	RegistrationBuilder &AddTableFunction(TableFunction &function) {
+		table_functions.push_back(&function);
+		return *this;
+	}
+
+	//! Register everything that was added - throws on the first failure.
+	const RegistrationStatistics &Register(duckdb_connection connection) {
+		statistics.phases.clear();
+
+		auto start = std::chrono::steady_clock::now();
+		for (auto type : types) {
+			if (duckdb_register_logical_type(connection, type->c_logical_type(), nullptr) != DuckDBSuccess) {
+				throw Exception("Failed to register type");
+			}
+		}
+		AddPhase("types", types.size(), start);
+
+		// Creating the C functions and handing them to DuckDB are timed separately.
+		start = std::chrono::steady_clock::now();
+		std::vector<CScalarFunction> single_functions;
+		std::vector<const std::string *> single_function_names;
+		std::vector<ScalarFunctionSet> function_sets;
+		for (auto &group : scalar_functions) {
+			if (group.functions.size() == 1) {
+				single_functions.push_back(group.functions[0]->CreateFunction(group.name.c_str()));
+				single_function_names.push_back(&group.name);
+				continue;
+			}
+			function_sets.emplace_back(group.name.c_str());
+			for (auto function : group.functions) {
+				function_sets.back().AddFunction(*function);
+			}
+		}
+		AddPhase("create scalar functions", scalar_function_count, start);
+
+		start = std::chrono::steady_clock::now();
+		for (idx_t i = 0; i < single_functions.size(); i++) {
+			auto function = single_functions[i].c_scalar_function();
+			if (duckdb_register_scalar_function(connection, function) != DuckDBSuccess) {
+				throw Exception("Failed to register scalar function " + *single_function_names[i]);
+			}
+		}
+		for (auto &function_set : function_sets) {
+			if (duckdb_register_scalar_function_set(connection, function_set.c_scalar_function_set()) !=
+			    DuckDBSuccess) {
+				throw Exception("Failed to register scalar function set");
+			}
+		}
+		AddPhase("register scalar functions", scalar_functions.size(), start);
+
+		start = std::chrono::steady_clock::now();
+		for (auto cast : casts) {
+			auto cast_function = cast->CreateFunction();
+			if (duckdb_register_cast_function(connection, cast_function.c_cast_function()) != DuckDBSuccess) {
+				throw Exception("Failed to register cast function");
+			}
+		}
+		AddPhase("casts", casts.size(), start);
+
+		start = std::chrono::steady_clock::now();
+		for (auto function : table_functions) {
+			auto table_function = function->CreateFunction();
+			if (duckdb_register_table_function(connection, table_function.c_table_function()) != DuckDBSuccess) {
+				throw Exception(std::string("Failed to register table function ") + function->Name());
+			}
+		}
+		AddPhase("table functions", table_functions.size(), start);
+		return statistics;
+	}
+
+	const RegistrationStatistics &Statistics() const {
+		return statistics;
+	}
+
+private:
+	struct ScalarFunctionGroup {
+		std::string name;
+		std::vector<ScalarFunction *> functions;
+	};
+
+	void AddPhase(const char *name, idx_t count, std::chrono::steady_clock::time_point start) {
+		auto end = std::chrono::steady_clock::now();
+		auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		statistics.phases.push_back(RegistrationPhase {name, count, static_cast<uint64_t>(nanoseconds)});
+	}
+
+private:
+	std::vector<LogicalType *> types;
+	//! Scalar functions grouped by name, in the order in which the names were first added.
+	std::vector<ScalarFunctionGroup> scalar_functions;
+	std::unordered_map<std::string, idx_t> scalar_function_sets;
+	idx_t scalar_function_count = 0;
+	std::vector<std::unique_ptr<ScalarFunction>> owned_functions;
+	std::vector<CastFunction *> casts;
+	std::vector<TableFunction *> table_functions;
+	RegistrationStatistics statistics;
+};
+
+} // namespace duckdb_stable
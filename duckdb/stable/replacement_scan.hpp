@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/replacement_scan.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/string_util.hpp"
+
+#include <string>
+#include <vector>
+
+namespace duckdb_stable {
+
+class ReplacementScanInfo {
+public:
+	explicit ReplacementScanInfo(duckdb_replacement_scan_info info_p) : info(info_p) {
+	}
+
+public:
+	//! Replace the table with a call to the given table function.
+	void SetFunctionName(const char *function_name) {
+		duckdb_replacement_scan_set_function_name(info, function_name);
+	}
+
+	void AddParameter(const std::string &parameter) {
+		auto value = duckdb_create_varchar_length(parameter.c_str(), parameter.size());
+		duckdb_replacement_scan_add_parameter(info, value);
+		duckdb_destroy_value(&value);
+	}
+
+	void AddParameter(int64_t parameter) {
+		auto value = duckdb_create_int64(parameter);
+		duckdb_replacement_scan_add_parameter(info, value);
+		duckdb_destroy_value(&value);
+	}
+
+public:
+	duckdb_replacement_scan_info c_replacement_scan_info() {
+		return info;
+	}
+
+private:
+	duckdb_replacement_scan_info info;
+};
+
+//! A replacement scan is consulted for every table name that the binder cannot find - e.g. the 'x.ext' in
+//! "SELECT * FROM 'x.ext'". Replacement scans are owned by the database once they are registered.
+class ReplacementScan {
+public:
+	virtual ~ReplacementScan() = default;
+
+	//! Returns whether the table was replaced. Exceptions are reported as errors of the query.
+	virtual bool Replace(const std::string &table_name, ReplacementScanInfo &info) = 0;
+
+public:
+	static void Callback(duckdb_replacement_scan_info info, const char *table_name, void *data) {
+		auto &scan = *reinterpret_cast<ReplacementScan *>(data);
+		try {
+			ReplacementScanInfo scan_info(info);
+			scan.Replace(table_name, scan_info);
+		} catch (std::exception &ex) {
+			duckdb_replacement_scan_set_error(info, ex.what());
+		}
+	}
+
+	static void Destroy(void *data) {
+		delete reinterpret_cast<ReplacementScan *>(data);
+	}
+};
+
+//! Routes paths that end in one of the given extensions (case-insensitive) to a table function, which receives the
+//! path as its first (VARCHAR) parameter.
+class FileReplacementScan : public ReplacementScan {
+public:
+	FileReplacementScan(std::string function_name_p, const std::vector<std::string> &extensions_p)
+	    : function_name(std::move(function_name_p)) {
+		for (auto &extension : extensions_p) {
+			extensions.push_back(StringUtil::Lower(extension));
+		}
+	}
+
+public:
+	bool Replace(const std::string &table_name, ReplacementScanInfo &info) override {
+		auto lower_name = StringUtil::Lower(table_name);
+		for (auto &extension : extensions) {
+			if (StringUtil::EndsWith(lower_name, extension)) {
+				info.SetFunctionName(function_name.c_str());
+				info.AddParameter(table_name);
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	std::string function_name;
+	std::vector<std::string> extensions;
+};
+
+} // namespace duckdb_stable
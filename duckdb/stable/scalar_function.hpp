@@ -11,8 +11,11 @@
 #include "duckdb/stable/common.hpp"
 #include "duckdb/stable/executor.hpp"
 #include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/function_profiler.hpp"
 #include "duckdb/stable/logical_type.hpp"
+#include "duckdb/stable/scalar_function_info.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,6 +68,23 @@ public:
 	virtual LogicalType ReturnType() const = 0;
 	virtual std::vector<LogicalType> Arguments() const = 0;
 	virtual duckdb_scalar_function_t GetFunction() const = 0;
+	virtual FunctionStability Stability() const {
+		return FunctionStability::CONSISTENT;
+	}
+	virtual FunctionNullHandling NullHandling() const {
+		return FunctionNullHandling::DEFAULT_NULL_HANDLING;
+	}
+	//! Whether the function accepts any number of trailing arguments of VarargsType().
+	virtual bool HasVarargs() const {
+		return false;
+	}
+	virtual LogicalType VarargsType() const {
+		throw Exception("scalarFunction does not have varargs");
+	}
+	//! Data that is shared by every execution of the function, see ScalarFunctionInfo.
+	virtual std::shared_ptr<void> FunctionData() const {
+		return nullptr;
+	}
 
 	CScalarFunction CreateFunction(const char *name_override = nullptr) {
 		auto scalar_function = duckdb_create_scalar_function();
@@ -72,8 +92,26 @@ public:
 		for (auto &arg : Arguments()) {
 			duckdb_scalar_function_add_parameter(scalar_function, arg.c_logical_type());
 		}
+		if (HasVarargs()) {
+			duckdb_scalar_function_set_varargs(scalar_function, VarargsType().c_logical_type());
+		}
 		duckdb_scalar_function_set_return_type(scalar_function, ReturnType().c_logical_type());
 		duckdb_scalar_function_set_function(scalar_function, GetFunction());
+		if (Stability() != FunctionStability::CONSISTENT) {
+			// The C API only knows volatile functions: CONSISTENT_WITHIN_QUERY must not be constant-folded either.
+			duckdb_scalar_function_set_volatile(scalar_function);
+		}
+		if (NullHandling() == FunctionNullHandling::SPECIAL_HANDLING) {
+			duckdb_scalar_function_set_special_handling(scalar_function);
+		}
+		std::unique_ptr<ScalarFunctionInfo> function_info(new ScalarFunctionInfo());
+		function_info->function_data = FunctionData();
+#ifdef DUCKDB_STABLE_PROFILING
+		function_info->profile = &FunctionProfiler::Get().Register(name_override ? name_override : Name());
+#endif
+		if (function_info->function_data || function_info->profile) {
+			duckdb_scalar_function_set_extra_info(scalar_function, function_info.release(), ScalarFunctionInfo::Destroy);
+		}
 		return CScalarFunction(scalar_function);
 	}
 };
@@ -123,11 +161,11 @@ template <class INPUT_TYPE, class RESULT_TYPE>
 class BaseUnaryFunction : public ScalarFunction {
 public:
 	LogicalType ReturnType() const override {
-		return TemplateToType::Convert<RESULT_TYPE>();
+		return TemplateToType::Intern<RESULT_TYPE>();
 	}
 	std::vector<LogicalType> Arguments() const override {
 		std::vector<LogicalType> arguments;
-		arguments.push_back(TemplateToType::Convert<INPUT_TYPE>());
+		arguments.push_back(TemplateToType::Intern<INPUT_TYPE>());
 		return arguments;
 	}
 };
@@ -144,15 +182,24 @@ public:
 		auto input_vec = chunk.GetVector(0);
 		Vector output_vec(output);
 		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
 
-		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE>(
+		using INPUT_ARG = ExecutorArgument<INPUT_TYPE, OperatorNullHandling<OP>::value>;
+		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
 			input_vec, output_vec, count,
-			[&](const typename INPUT_TYPE::ARG_TYPE &input_val) { return OP::Operation(input_val); });
+			[&](const typename INPUT_ARG::ARG_TYPE &input_val) { return OP::Operation(input_val); });
 	}
 
 	duckdb_scalar_function_t GetFunction() const override {
 		return ExecuteUnary;
 	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
 };
 
 template <class OP, class INPUT_TYPE_T, class RETURN_TYPE_T, class STATIC_T>
@@ -168,28 +215,85 @@ public:
 		auto input_vec = chunk.GetVector(0);
 		Vector output_vec(output);
 		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
 
+		using INPUT_ARG = ExecutorArgument<INPUT_TYPE, OperatorNullHandling<OP>::value>;
 		typename OP::STATIC_DATA static_data;
-		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE>(
+		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
+		    input_vec, output_vec, count,
+		    [&](const typename INPUT_ARG::ARG_TYPE &input_val) { return OP::Operation(input_val, static_data); });
+	}
+
+	duckdb_scalar_function_t GetFunction() const override {
+		return ExecuteUnary;
+	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
+};
+
+//! A unary function over data that is shared by every execution (and connection) - OP::Operation(input, data).
+template <class OP, class INPUT_TYPE_T, class RETURN_TYPE_T, class DATA_T>
+class UnaryFunctionData : public BaseUnaryFunction<INPUT_TYPE_T, RETURN_TYPE_T> {
+public:
+	using INPUT_TYPE = INPUT_TYPE_T;
+	using RESULT_TYPE = RETURN_TYPE_T;
+	using DATA = DATA_T;
+
+	explicit UnaryFunctionData(std::shared_ptr<DATA> data_p) : data(std::move(data_p)) {
+		if (!data) {
+			throw Exception("UnaryFunctionData requires function data, got an empty shared_ptr");
+		}
+	}
+
+	static void ExecuteUnary(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		auto input_vec = chunk.GetVector(0);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		using INPUT_ARG = ExecutorArgument<INPUT_TYPE, OperatorNullHandling<OP>::value>;
+		auto &function_data = *reinterpret_cast<DATA *>(ScalarFunctionInfo::Get(info)->function_data.get());
+		executor.ExecuteUnary<INPUT_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
 		    input_vec, output_vec, count,
-		    [&](const typename INPUT_TYPE::ARG_TYPE &input_val) { return OP::Operation(input_val, static_data); });
+		    [&](const typename INPUT_ARG::ARG_TYPE &input_val) { return OP::Operation(input_val, function_data); });
 	}
 
 	duckdb_scalar_function_t GetFunction() const override {
 		return ExecuteUnary;
 	}
+
+	std::shared_ptr<void> FunctionData() const override {
+		return data;
+	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
+
+private:
+	std::shared_ptr<DATA> data;
 };
 
 template <class A_TYPE, class B_TYPE, class RESULT_TYPE>
 class BaseBinaryFunction : public ScalarFunction {
 public:
 	LogicalType ReturnType() const override {
-		return TemplateToType::Convert<RESULT_TYPE>();
+		return TemplateToType::Intern<RESULT_TYPE>();
 	}
 	std::vector<LogicalType> Arguments() const override {
 		std::vector<LogicalType> arguments;
-		arguments.push_back(TemplateToType::Convert<A_TYPE>());
-		arguments.push_back(TemplateToType::Convert<B_TYPE>());
+		arguments.push_back(TemplateToType::Intern<A_TYPE>());
+		arguments.push_back(TemplateToType::Intern<B_TYPE>());
 		return arguments;
 	}
 };
@@ -208,10 +312,13 @@ public:
 		auto b_vec = chunk.GetVector(1);
 		Vector output_vec(output);
 		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
 
-		executor.ExecuteBinary<A_TYPE, B_TYPE, RESULT_TYPE>(
+		using A_ARG = ExecutorArgument<A_TYPE, OperatorNullHandling<OP>::value>;
+		using B_ARG = ExecutorArgument<B_TYPE, OperatorNullHandling<OP>::value>;
+		executor.ExecuteBinary<A_TYPE, B_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
 		    a_vec, b_vec, output_vec, count,
-		    [&](const typename A_TYPE::ARG_TYPE &a_val, const typename B_TYPE::ARG_TYPE &b_val) {
+		    [&](const typename A_ARG::ARG_TYPE &a_val, const typename B_ARG::ARG_TYPE &b_val) {
 			    return OP::Operation(a_val, b_val);
 		    });
 	}
@@ -219,6 +326,13 @@ public:
 	duckdb_scalar_function_t GetFunction() const override {
 		return ExecuteBinary;
 	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
 };
 
 template <class OP, class A_TYPE_T, class B_TYPE_T, class RETURN_TYPE_T, class STATIC_T>
@@ -236,11 +350,14 @@ public:
 		auto b_vec = chunk.GetVector(1);
 		Vector output_vec(output);
 		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
 
+		using A_ARG = ExecutorArgument<A_TYPE, OperatorNullHandling<OP>::value>;
+		using B_ARG = ExecutorArgument<B_TYPE, OperatorNullHandling<OP>::value>;
 		STATIC_DATA static_data;
-		executor.ExecuteBinary<A_TYPE, B_TYPE, RESULT_TYPE>(
+		executor.ExecuteBinary<A_TYPE, B_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
 		    a_vec, b_vec, output_vec, count,
-		    [&](const typename A_TYPE::ARG_TYPE &a_val, const typename B_TYPE::ARG_TYPE &b_val) {
+		    [&](const typename A_ARG::ARG_TYPE &a_val, const typename B_ARG::ARG_TYPE &b_val) {
 			    return OP::Operation(a_val, b_val, static_data);
 		    });
 	}
@@ -248,6 +365,57 @@ public:
 	duckdb_scalar_function_t GetFunction() const override {
 		return ExecuteBinary;
 	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
+};
+
+template <class OP, class ARG_TYPE_T, class RETURN_TYPE_T>
+class VarargsFunction : public ScalarFunction {
+public:
+	using ARG_TYPE = ARG_TYPE_T;
+	using RESULT_TYPE = RETURN_TYPE_T;
+
+	LogicalType ReturnType() const override {
+		return TemplateToType::Intern<RESULT_TYPE>();
+	}
+	std::vector<LogicalType> Arguments() const override {
+		return std::vector<LogicalType>();
+	}
+	bool HasVarargs() const override {
+		return true;
+	}
+	LogicalType VarargsType() const override {
+		return TemplateToType::Intern<ARG_TYPE>();
+	}
+
+	static void ExecuteVarargs(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output) {
+		FunctionExecutor executor(info);
+		DataChunk chunk(input);
+		Vector output_vec(output);
+		auto count = chunk.Size();
+		DUCKDB_STABLE_PROFILE_FUNCTION(info, executor, output_vec, count);
+
+		using INPUT_ARG = ExecutorArgument<ARG_TYPE, OperatorNullHandling<OP>::value>;
+		executor.ExecuteVarargs<ARG_TYPE, RESULT_TYPE, OperatorNullHandling<OP>::value>(
+		    chunk, output_vec, count,
+		    [&](const VarargsRow<typename INPUT_ARG::ARG_TYPE> &input_row) { return OP::Operation(input_row); });
+	}
+
+	duckdb_scalar_function_t GetFunction() const override {
+		return ExecuteVarargs;
+	}
+
+	FunctionStability Stability() const override {
+		return OperatorStability<OP>::value;
+	}
+	FunctionNullHandling NullHandling() const override {
+		return OperatorNullHandling<OP>::value;
+	}
 };
 
 } // namespace duckdb_stable
@@ -0,0 +1,35 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/scalar_function_info.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+
+#include <memory>
+
+namespace duckdb_stable {
+
+class FunctionProfile;
+
+//! The extra info that ScalarFunction::CreateFunction attaches to a function. It is only created when the function
+//! has data or is profiled, and is freed by DuckDB together with the function - the data is shared by every
+//! connection that executes the function.
+struct ScalarFunctionInfo {
+	std::shared_ptr<void> function_data;
+	FunctionProfile *profile = nullptr;
+
+	static ScalarFunctionInfo *Get(duckdb_function_info info) {
+		return reinterpret_cast<ScalarFunctionInfo *>(duckdb_scalar_function_get_extra_info(info));
+	}
+
+	static void Destroy(void *data) {
+		delete reinterpret_cast<ScalarFunctionInfo *>(data);
+	}
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,580 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/string_kernels.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/executor_types.hpp"
+#include "duckdb/stable/scalar_function.hpp"
+#include "duckdb/stable/string_type.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The kernels are vectorized at compile time: with AVX2 when the extension is compiled with it (e.g. -mavx2), with
+// SSE2 on every other x86-64 build and byte- or word-at-a-time elsewhere. Define DUCKDB_STABLE_DISABLE_SIMD to force
+// the scalar kernels.
+#if !defined(DUCKDB_STABLE_DISABLE_SIMD) && defined(__AVX2__)
+#define DUCKDB_STABLE_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(DUCKDB_STABLE_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define DUCKDB_STABLE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace duckdb_stable {
+
+#if defined(DUCKDB_STABLE_SIMD_AVX2) || defined(DUCKDB_STABLE_SIMD_SSE2)
+#define DUCKDB_STABLE_SIMD
+
+//! The byte-wise operations the string kernels need, on the widest register available. Masks have one bit per byte.
+struct SimdBytes {
+#ifdef DUCKDB_STABLE_SIMD_AVX2
+	static constexpr idx_t SIZE = 32;
+	using register_t = __m256i;
+
+	static register_t Load(const char *ptr) {
+		return _mm256_loadu_si256(reinterpret_cast<const register_t *>(ptr));
+	}
+	static void Store(char *ptr, register_t value) {
+		_mm256_storeu_si256(reinterpret_cast<register_t *>(ptr), value);
+	}
+	static register_t Broadcast(char c) {
+		return _mm256_set1_epi8(c);
+	}
+	static uint32_t EqualMask(register_t a, register_t b) {
+		return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+	}
+	static uint32_t HighBitMask(register_t value) {
+		return static_cast<uint32_t>(_mm256_movemask_epi8(value));
+	}
+	//! Adds delta to every byte in [lower, upper] - both bounds must be ASCII.
+	static register_t AddInRange(register_t value, char lower, char upper, char delta) {
+		auto above = _mm256_cmpgt_epi8(value, Broadcast(static_cast<char>(lower - 1)));
+		auto below = _mm256_cmpgt_epi8(Broadcast(static_cast<char>(upper + 1)), value);
+		auto in_range = _mm256_and_si256(above, below);
+		return _mm256_add_epi8(value, _mm256_and_si256(in_range, Broadcast(delta)));
+	}
+#else
+	static constexpr idx_t SIZE = 16;
+	using register_t = __m128i;
+
+	static register_t Load(const char *ptr) {
+		return _mm_loadu_si128(reinterpret_cast<const register_t *>(ptr));
+	}
+	static void Store(char *ptr, register_t value) {
+		_mm_storeu_si128(reinterpret_cast<register_t *>(ptr), value);
+	}
+	static register_t Broadcast(char c) {
+		return _mm_set1_epi8(c);
+	}
+	static uint32_t EqualMask(register_t a, register_t b) {
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+	}
+	static uint32_t HighBitMask(register_t value) {
+		return static_cast<uint32_t>(_mm_movemask_epi8(value));
+	}
+	//! Adds delta to every byte in [lower, upper] - both bounds must be ASCII.
+	static register_t AddInRange(register_t value, char lower, char upper, char delta) {
+		auto above = _mm_cmpgt_epi8(value, Broadcast(static_cast<char>(lower - 1)));
+		auto below = _mm_cmpgt_epi8(Broadcast(static_cast<char>(upper + 1)), value);
+		auto in_range = _mm_and_si128(above, below);
+		return _mm_add_epi8(value, _mm_and_si128(in_range, Broadcast(delta)));
+	}
+#endif
+
+	static idx_t CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return static_cast<idx_t>(__builtin_ctz(mask));
+#endif
+	}
+};
+#endif
+
+//! Vectorized primitives over string bytes. Case folding only maps ASCII letters - other bytes (and therefore all
+//! multi-byte UTF-8 characters) are copied unchanged.
+class StringKernels {
+public:
+	static constexpr idx_t NOT_FOUND = static_cast<idx_t>(-1);
+	//! Below this many bytes a plain loop beats calling memchr.
+	static constexpr idx_t SHORT_SCAN_SIZE = 16;
+
+public:
+	static bool IsAscii(const char *data, idx_t size) {
+		return AsciiPrefixLength(data, size) == size;
+	}
+
+	static bool IsAscii(const string_t &input) {
+		return IsAscii(input.GetData(), input.GetSize());
+	}
+
+	//! Whether the bytes are well-formed UTF-8: no overlong encodings, surrogates or code points above U+10FFFF.
+	static bool IsValidUTF8(const char *data, idx_t size) {
+		auto bytes = reinterpret_cast<const unsigned char *>(data);
+		idx_t i = 0;
+		while (i < size) {
+			i += AsciiPrefixLength(data + i, size - i);
+			if (i >= size) {
+				break;
+			}
+			auto c = bytes[i];
+			idx_t continuation_bytes;
+			uint32_t code_point;
+			if (c >= 0xC2 && c <= 0xDF) {
+				continuation_bytes = 1;
+				code_point = c & 0x1F;
+			} else if ((c & 0xF0) == 0xE0) {
+				continuation_bytes = 2;
+				code_point = c & 0x0F;
+			} else if (c >= 0xF0 && c <= 0xF4) {
+				continuation_bytes = 3;
+				code_point = c & 0x07;
+			} else {
+				return false;
+			}
+			if (continuation_bytes >= size - i) {
+				return false;
+			}
+			for (idx_t k = 1; k <= continuation_bytes; k++) {
+				auto b = bytes[i + k];
+				if ((b & 0xC0) != 0x80) {
+					return false;
+				}
+				code_point = (code_point << 6) | (b & 0x3F);
+			}
+			if (continuation_bytes == 2 && (code_point < 0x800 || (code_point >= 0xD800 && code_point <= 0xDFFF))) {
+				return false;
+			}
+			if (continuation_bytes == 3 && (code_point < 0x10000 || code_point > 0x10FFFF)) {
+				return false;
+			}
+			i += continuation_bytes + 1;
+		}
+		return true;
+	}
+
+	static bool IsValidUTF8(const string_t &input) {
+		return IsValidUTF8(input.GetData(), input.GetSize());
+	}
+
+	//! Write the input with ASCII letters in lower case to result, which must hold size bytes.
+	static void AsciiLower(const char *data, idx_t size, char *result) {
+		AddInRange(data, size, result, 'A', 'Z', 'a' - 'A');
+	}
+
+	//! Write the input with ASCII letters in upper case to result, which must hold size bytes.
+	static void AsciiUpper(const char *data, idx_t size, char *result) {
+		AddInRange(data, size, result, 'a', 'z', static_cast<char>('A' - 'a'));
+	}
+
+	//! The position of the first occurrence of c, or NOT_FOUND.
+	static idx_t FindByte(const char *data, idx_t size, char c) {
+		idx_t i = 0;
+#ifdef DUCKDB_STABLE_SIMD
+		auto target = SimdBytes::Broadcast(c);
+		for (; i + SimdBytes::SIZE <= size; i += SimdBytes::SIZE) {
+			auto mask = SimdBytes::EqualMask(SimdBytes::Load(data + i), target);
+			if (mask) {
+				return i + SimdBytes::CountTrailingZeros(mask);
+			}
+		}
+#endif
+		if (size - i >= SHORT_SCAN_SIZE) {
+			auto found = static_cast<const char *>(memchr(data + i, c, size - i));
+			return found ? static_cast<idx_t>(found - data) : NOT_FOUND;
+		}
+		for (; i < size; i++) {
+			if (data[i] == c) {
+				return i;
+			}
+		}
+		return NOT_FOUND;
+	}
+
+	//! The position of the first occurrence of needle in haystack, or NOT_FOUND. Candidates are found by comparing
+	//! the first and the last byte of the needle for a full register of positions at once.
+	static idx_t Find(const char *haystack, idx_t haystack_size, const char *needle, idx_t needle_size) {
+		if (needle_size == 0) {
+			return 0;
+		}
+		if (needle_size > haystack_size) {
+			return NOT_FOUND;
+		}
+		if (needle_size == 1) {
+			return FindByte(haystack, haystack_size, needle[0]);
+		}
+		auto last_start = haystack_size - needle_size;
+		idx_t i = 0;
+#ifdef DUCKDB_STABLE_SIMD
+		auto first = SimdBytes::Broadcast(needle[0]);
+		auto last = SimdBytes::Broadcast(needle[needle_size - 1]);
+		for (; i + SimdBytes::SIZE <= last_start + 1; i += SimdBytes::SIZE) {
+			auto mask = SimdBytes::EqualMask(SimdBytes::Load(haystack + i), first) &
+			            SimdBytes::EqualMask(SimdBytes::Load(haystack + i + needle_size - 1), last);
+			while (mask) {
+				auto position = i + SimdBytes::CountTrailingZeros(mask);
+				if (BytesEqual(haystack + position + 1, needle + 1, needle_size - 2)) {
+					return position;
+				}
+				mask &= mask - 1;
+			}
+		}
+#endif
+		// Long remainders (i.e. without SIMD) jump between candidates with memchr, short ones are scanned directly.
+		while (last_start - i + 1 >= SHORT_SCAN_SIZE) {
+			auto found = static_cast<const char *>(memchr(haystack + i, needle[0], last_start - i + 1));
+			if (!found) {
+				return NOT_FOUND;
+			}
+			i = static_cast<idx_t>(found - haystack);
+			if (MatchAt(haystack + i, needle, needle_size)) {
+				return i;
+			}
+			i++;
+		}
+		for (; i <= last_start; i++) {
+			if (haystack[i] == needle[0] && MatchAt(haystack + i, needle, needle_size)) {
+				return i;
+			}
+		}
+		return NOT_FOUND;
+	}
+
+	static idx_t Find(const string_t &haystack, const string_t &needle) {
+		return Find(haystack.GetData(), haystack.GetSize(), needle.GetData(), needle.GetSize());
+	}
+
+	static bool Contains(const string_t &haystack, const string_t &needle) {
+		return Find(haystack, needle) != NOT_FOUND;
+	}
+
+	static bool StartsWith(const string_t &input, const string_t &prefix) {
+		return prefix.GetSize() <= input.GetSize() &&
+		       memcmp(input.GetData(), prefix.GetData(), prefix.GetSize()) == 0;
+	}
+
+	static bool EndsWith(const string_t &input, const string_t &suffix) {
+		return suffix.GetSize() <= input.GetSize() &&
+		       memcmp(input.GetData() + input.GetSize() - suffix.GetSize(), suffix.GetData(), suffix.GetSize()) == 0;
+	}
+
+private:
+	//! Whether the needle (of at least two bytes) occurs at the candidate, whose first byte is known to match.
+	static bool MatchAt(const char *candidate, const char *needle, idx_t needle_size) {
+		return candidate[needle_size - 1] == needle[needle_size - 1] &&
+		       BytesEqual(candidate + 1, needle + 1, needle_size - 2);
+	}
+
+	static bool BytesEqual(const char *a, const char *b, idx_t size) {
+		if (size >= SHORT_SCAN_SIZE) {
+			return memcmp(a, b, size) == 0;
+		}
+		for (idx_t i = 0; i < size; i++) {
+			if (a[i] != b[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//! The number of leading ASCII bytes.
+	static idx_t AsciiPrefixLength(const char *data, idx_t size) {
+		idx_t i = 0;
+#ifdef DUCKDB_STABLE_SIMD
+		for (; i + SimdBytes::SIZE <= size; i += SimdBytes::SIZE) {
+			if (SimdBytes::HighBitMask(SimdBytes::Load(data + i))) {
+				break;
+			}
+		}
+#endif
+		for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+			uint64_t word;
+			memcpy(&word, data + i, sizeof(uint64_t));
+			if (word & 0x8080808080808080ULL) {
+				break;
+			}
+		}
+		while (i < size && !(static_cast<unsigned char>(data[i]) & 0x80)) {
+			i++;
+		}
+		return i;
+	}
+
+	static void AddInRange(const char *data, idx_t size, char *result, char lower, char upper, char delta) {
+		idx_t i = 0;
+#ifdef DUCKDB_STABLE_SIMD
+		for (; i + SimdBytes::SIZE <= size; i += SimdBytes::SIZE) {
+			SimdBytes::Store(result + i, SimdBytes::AddInRange(SimdBytes::Load(data + i), lower, upper, delta));
+		}
+#endif
+		for (; i < size; i++) {
+			auto c = data[i];
+			result[i] = c >= lower && c <= upper ? static_cast<char>(c + delta) : c;
+		}
+	}
+};
+
+//! Finds the first occurrence of any of a fixed set of needles. Positions are filtered on the first byte of the
+//! needles - with a register-wide comparison when the needles start with at most MAX_SIMD_FIRST_BYTES distinct bytes,
+//! with a lookup table otherwise - and only the needles that start with the byte at a candidate position are compared.
+class MultiNeedleMatcher {
+public:
+	static constexpr idx_t MAX_SIMD_FIRST_BYTES = 4;
+
+	explicit MultiNeedleMatcher(std::vector<std::string> needles_p) : needles(std::move(needles_p)) {
+		empty_needle = StringKernels::NOT_FOUND;
+		for (idx_t i = 0; i < 256; i++) {
+			is_first_byte[i] = false;
+		}
+		for (idx_t n = 0; n < needles.size(); n++) {
+			if (needles[n].empty()) {
+				empty_needle = std::min(empty_needle, n);
+				continue;
+			}
+			order.push_back(n);
+		}
+		// Group the needles by their first byte, keeping the order of needles that share one.
+		std::stable_sort(order.begin(), order.end(),
+		                 [&](idx_t a, idx_t b) { return FirstByte(needles[a]) < FirstByte(needles[b]); });
+		for (idx_t i = 0; i <= 256; i++) {
+			bucket_start[i] = 0;
+		}
+		for (auto n : order) {
+			auto first_byte = FirstByte(needles[n]);
+			bucket_start[first_byte + 1]++;
+			if (!is_first_byte[first_byte]) {
+				is_first_byte[first_byte] = true;
+				first_bytes.push_back(static_cast<char>(first_byte));
+			}
+		}
+		for (idx_t i = 1; i <= 256; i++) {
+			bucket_start[i] += bucket_start[i - 1];
+		}
+	}
+
+public:
+	idx_t NeedleCount() const {
+		return needles.size();
+	}
+
+	//! The position of the first match, or NOT_FOUND. needle_index is set to the needle that matched - the first
+	//! needle in the given order if several match at that position.
+	idx_t Find(const char *data, idx_t size, idx_t &needle_index) const {
+		if (empty_needle != StringKernels::NOT_FOUND) {
+			idx_t other_needle;
+			auto other_match = size > 0 && is_first_byte[static_cast<unsigned char>(data[0])] &&
+			                   MatchAt(data, size, 0, other_needle) && other_needle < empty_needle;
+			needle_index = other_match ? other_needle : empty_needle;
+			return 0;
+		}
+		idx_t i = 0;
+#ifdef DUCKDB_STABLE_SIMD
+		if (!first_bytes.empty() && first_bytes.size() <= MAX_SIMD_FIRST_BYTES) {
+			SimdBytes::register_t targets[MAX_SIMD_FIRST_BYTES];
+			for (idx_t b = 0; b < first_bytes.size(); b++) {
+				targets[b] = SimdBytes::Broadcast(first_bytes[b]);
+			}
+			for (; i + SimdBytes::SIZE <= size; i += SimdBytes::SIZE) {
+				auto block = SimdBytes::Load(data + i);
+				uint32_t mask = 0;
+				for (idx_t b = 0; b < first_bytes.size(); b++) {
+					mask |= SimdBytes::EqualMask(block, targets[b]);
+				}
+				while (mask) {
+					auto position = i + SimdBytes::CountTrailingZeros(mask);
+					if (MatchAt(data, size, position, needle_index)) {
+						return position;
+					}
+					mask &= mask - 1;
+				}
+			}
+		}
+#endif
+		for (; i < size; i++) {
+			if (is_first_byte[static_cast<unsigned char>(data[i])] && MatchAt(data, size, i, needle_index)) {
+				return i;
+			}
+		}
+		return StringKernels::NOT_FOUND;
+	}
+
+	bool ContainsAny(const char *data, idx_t size) const {
+		idx_t needle_index;
+		return Find(data, size, needle_index) != StringKernels::NOT_FOUND;
+	}
+
+	bool ContainsAny(const string_t &input) const {
+		return ContainsAny(input.GetData(), input.GetSize());
+	}
+
+private:
+	static idx_t FirstByte(const std::string &needle) {
+		return static_cast<unsigned char>(needle[0]);
+	}
+
+	bool MatchAt(const char *data, idx_t size, idx_t position, idx_t &needle_index) const {
+		auto first_byte = static_cast<unsigned char>(data[position]);
+		auto remaining = size - position;
+		for (idx_t i = bucket_start[first_byte]; i < bucket_start[first_byte + 1]; i++) {
+			auto &needle = needles[order[i]];
+			if (needle.size() <= remaining && memcmp(data + position, needle.data(), needle.size()) == 0) {
+				needle_index = order[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	std::vector<std::string> needles;
+	//! The index of the first empty needle, which matches every input at position 0.
+	idx_t empty_needle;
+	//! The non-empty needles ordered by their first byte, bucket_start[b] is the first of those starting with b.
+	std::vector<idx_t> order;
+	idx_t bucket_start[257];
+	bool is_first_byte[256];
+	std::vector<char> first_bytes;
+};
+
+struct ValidUTF8Operator {
+	static bool Operation(const string_t &input) {
+		return StringKernels::IsValidUTF8(input);
+	}
+};
+
+struct AsciiLowerOperator {
+	//! The result of a row is built here and copied into the result vector before the next row is processed.
+	using STATIC_DATA = std::string;
+
+	static string_t Operation(const string_t &input, std::string &buffer) {
+		buffer.resize(input.GetSize());
+		StringKernels::AsciiLower(input.GetData(), input.GetSize(), &buffer[0]);
+		return string_t(buffer.data(), input.GetSize());
+	}
+};
+
+struct AsciiUpperOperator {
+	//! The result of a row is built here and copied into the result vector before the next row is processed.
+	using STATIC_DATA = std::string;
+
+	static string_t Operation(const string_t &input, std::string &buffer) {
+		buffer.resize(input.GetSize());
+		StringKernels::AsciiUpper(input.GetData(), input.GetSize(), &buffer[0]);
+		return string_t(buffer.data(), input.GetSize());
+	}
+};
+
+struct ContainsOperator {
+	static bool Operation(const string_t &haystack, const string_t &needle) {
+		return StringKernels::Contains(haystack, needle);
+	}
+};
+
+struct StartsWithOperator {
+	static bool Operation(const string_t &input, const string_t &prefix) {
+		return StringKernels::StartsWith(input, prefix);
+	}
+};
+
+struct EndsWithOperator {
+	static bool Operation(const string_t &input, const string_t &suffix) {
+		return StringKernels::EndsWith(input, suffix);
+	}
+};
+
+struct ContainsAnyOperator {
+	static bool Operation(const string_t &input, const MultiNeedleMatcher &matcher) {
+		return matcher.ContainsAny(input);
+	}
+};
+
+// Ready-made functions over the kernels. Their names do not clash with the DuckDB built-ins, register them under
+// another name with RegistrationBuilder::AddFunction(name, function).
+
+//! is_valid_utf8(VARCHAR) -> BOOLEAN
+class ValidUTF8Function : public UnaryFunction<ValidUTF8Operator, PrimitiveType<string_t>, PrimitiveType<bool>> {
+public:
+	const char *Name() const override {
+		return "is_valid_utf8";
+	}
+};
+
+//! ascii_lower(VARCHAR) -> VARCHAR
+class AsciiLowerFunction
+    : public UnaryFunctionExt<AsciiLowerOperator, PrimitiveType<string_t>, PrimitiveType<string_t>, std::string> {
+public:
+	const char *Name() const override {
+		return "ascii_lower";
+	}
+};
+
+//! ascii_upper(VARCHAR) -> VARCHAR
+class AsciiUpperFunction
+    : public UnaryFunctionExt<AsciiUpperOperator, PrimitiveType<string_t>, PrimitiveType<string_t>, std::string> {
+public:
+	const char *Name() const override {
+		return "ascii_upper";
+	}
+};
+
+//! str_contains(haystack VARCHAR, needle VARCHAR) -> BOOLEAN
+class ContainsFunction : public BinaryFunction<ContainsOperator, PrimitiveType<string_t>, PrimitiveType<string_t>,
+                                               PrimitiveType<bool>> {
+public:
+	const char *Name() const override {
+		return "str_contains";
+	}
+};
+
+//! str_starts_with(input VARCHAR, prefix VARCHAR) -> BOOLEAN
+class StartsWithFunction : public BinaryFunction<StartsWithOperator, PrimitiveType<string_t>, PrimitiveType<string_t>,
+                                                 PrimitiveType<bool>> {
+public:
+	const char *Name() const override {
+		return "str_starts_with";
+	}
+};
+
+//! str_ends_with(input VARCHAR, suffix VARCHAR) -> BOOLEAN
+class EndsWithFunction : public BinaryFunction<EndsWithOperator, PrimitiveType<string_t>, PrimitiveType<string_t>,
+                                               PrimitiveType<bool>> {
+public:
+	const char *Name() const override {
+		return "str_ends_with";
+	}
+};
+
+//! name(input VARCHAR) -> BOOLEAN: whether the input contains any of the needles the function was created with.
+class ContainsAnyFunction : public UnaryFunctionData<ContainsAnyOperator, PrimitiveType<string_t>, PrimitiveType<bool>,
+                                                     MultiNeedleMatcher> {
+public:
+	ContainsAnyFunction(std::string name_p, std::vector<std::string> needles)
+	    : UnaryFunctionData(std::make_shared<MultiNeedleMatcher>(std::move(needles))), name(std::move(name_p)) {
+	}
+
+	const char *Name() const override {
+		return name.c_str();
+	}
+
+private:
+	std::string name;
+};
+
+} // namespace duckdb_stable
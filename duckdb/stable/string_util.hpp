@@ -10,6 +10,7 @@
 
 #include "duckdb/stable/common.hpp"
 
+#include <cctype>
 #include <limits>
 #include <string>
 #include <vector>
@@ -64,6 +65,21 @@ public:
 		}
 		return result;
 	}
+
+	static std::string Lower(const std::string &str) {
+		std::string result(str);
+		for (auto &c : result) {
+			c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		}
+		return result;
+	}
+
+	static bool EndsWith(const std::string &str, const std::string &suffix) {
+		if (suffix.size() > str.size()) {
+			return false;
+		}
+		return str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
 };
 
 } // namespace duckdb_stable
@@ -0,0 +1,352 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/table_function.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/data_chunk.hpp"
+#include "duckdb/stable/exception.hpp"
+#include "duckdb/stable/logical_type.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace duckdb_stable {
+
+class CTableFunction {
+public:
+	CTableFunction(duckdb_table_function function_p) : function(function_p) {
+	}
+	~CTableFunction() {
+		if (function) {
+			duckdb_destroy_table_function(&function);
+		}
+	}
+
+	//! Disable copy constructors.
+	CTableFunction(const CTableFunction &other) = delete;
+	CTableFunction &operator=(const CTableFunction &) = delete;
+
+	//! Enable move constructors.
+	CTableFunction(CTableFunction &&other) noexcept : function(nullptr) {
+		std::swap(function, other.function);
+	}
+	CTableFunction &operator=(CTableFunction &&other) noexcept {
+		std::swap(function, other.function);
+		return *this;
+	}
+
+public:
+	duckdb_table_function c_table_function() {
+		return function;
+	}
+
+private:
+	duckdb_table_function function;
+};
+
+class TableFunctionBindInfo {
+public:
+	explicit TableFunctionBindInfo(duckdb_bind_info info_p) : info(info_p) {
+	}
+
+public:
+	void AddResultColumn(const char *name, LogicalType type) {
+		duckdb_bind_add_result_column(info, name, type.c_logical_type());
+	}
+
+	idx_t ParameterCount() {
+		return duckdb_bind_get_parameter_count(info);
+	}
+
+	std::string GetVarcharParameter(const idx_t index) {
+		auto value = duckdb_bind_get_parameter(info, index);
+		auto str = duckdb_get_varchar(value);
+		std::string result(str);
+		duckdb_free(str);
+		duckdb_destroy_value(&value);
+		return result;
+	}
+
+	int64_t GetInt64Parameter(const idx_t index) {
+		auto value = duckdb_bind_get_parameter(info, index);
+		auto result = duckdb_get_int64(value);
+		duckdb_destroy_value(&value);
+		return result;
+	}
+
+	//! The number of rows the scan emits, which DuckDB uses to order joins and size hash tables. Without it, the
+	//! planner assumes a small table. Sources that can only estimate it (e.g. from the file size) pass is_exact = false.
+	void SetCardinality(idx_t cardinality, bool is_exact) {
+		duckdb_bind_set_cardinality(info, cardinality, is_exact);
+	}
+
+public:
+	duckdb_bind_info c_bind_info() {
+		return info;
+	}
+
+private:
+	duckdb_bind_info info;
+};
+
+class TableFunctionInitInfo {
+public:
+	explicit TableFunctionInitInfo(duckdb_init_info info_p) : info(info_p) {
+	}
+
+public:
+	void SetMaxThreads(const idx_t max_threads) {
+		duckdb_init_set_max_threads(info, max_threads);
+	}
+
+	//! With projection pushdown: the number of columns to emit.
+	idx_t ColumnCount() {
+		return duckdb_init_get_column_count(info);
+	}
+
+	//! With projection pushdown: the bound result column that output column "index" holds.
+	idx_t GetColumnIndex(const idx_t index) {
+		return duckdb_init_get_column_index(info, index);
+	}
+
+	std::vector<idx_t> GetColumnIndexes() {
+		std::vector<idx_t> result;
+		auto column_count = ColumnCount();
+		for (idx_t i = 0; i < column_count; i++) {
+			result.push_back(GetColumnIndex(i));
+		}
+		return result;
+	}
+
+public:
+	duckdb_init_info c_init_info() {
+		return info;
+	}
+
+private:
+	duckdb_init_info info;
+};
+
+//! What a table function knows about its output before it is scanned.
+struct TableStatistics {
+	TableStatistics() : has_cardinality(false), cardinality(0), cardinality_is_exact(false) {
+	}
+
+	void SetCardinality(idx_t cardinality_p, bool is_exact) {
+		has_cardinality = true;
+		cardinality = cardinality_p;
+		cardinality_is_exact = is_exact;
+	}
+
+	bool has_cardinality;
+	idx_t cardinality;
+	bool cardinality_is_exact;
+};
+
+class TableFunction {
+public:
+	virtual ~TableFunction() = default;
+
+	virtual const char *Name() const = 0;
+	virtual std::vector<LogicalType> Arguments() const {
+		return std::vector<LogicalType>();
+	}
+	virtual duckdb_table_function_bind_t GetBind() const = 0;
+	virtual duckdb_table_function_init_t GetInit() const = 0;
+	virtual duckdb_table_function_t GetFunction() const = 0;
+	//! Initializes the state of every thread that scans, nullptr when the scan has no local state.
+	virtual duckdb_table_function_init_t GetLocalInit() const {
+		return nullptr;
+	}
+	//! Whether the scan only emits the columns that the query uses (see TableFunctionInitInfo::GetColumnIndexes).
+	virtual bool ProjectionPushdown() const {
+		return false;
+	}
+
+	CTableFunction CreateFunction() {
+		auto table_function = duckdb_create_table_function();
+		duckdb_table_function_set_name(table_function, Name());
+		for (auto &arg : Arguments()) {
+			duckdb_table_function_add_parameter(table_function, arg.c_logical_type());
+		}
+		duckdb_table_function_set_bind(table_function, GetBind());
+		duckdb_table_function_set_init(table_function, GetInit());
+		if (GetLocalInit()) {
+			duckdb_table_function_set_local_init(table_function, GetLocalInit());
+		}
+		duckdb_table_function_set_function(table_function, GetFunction());
+		if (ProjectionPushdown()) {
+			duckdb_table_function_supports_projection_pushdown(table_function, true);
+		}
+		return CTableFunction(table_function);
+	}
+};
+
+//! Operators can declare "static constexpr bool PROJECTION_PUSHDOWN = true" - Scan then only fills the columns
+//! returned by TableFunctionInitInfo::GetColumnIndexes, in that order.
+template <class OP, class = void>
+struct OperatorProjectionPushdown {
+	static constexpr bool value = false;
+};
+
+template <class OP>
+struct OperatorProjectionPushdown<OP, decltype(void(OP::PROJECTION_PUSHDOWN))> {
+	static constexpr bool value = OP::PROJECTION_PUSHDOWN;
+};
+
+//! Operators can provide "static void Statistics(const BIND_DATA &bind_data, TableStatistics &statistics)", which
+//! is called after Bind and reports the statistics to the planner. Any function named Statistics is called, so one
+//! with a different signature fails to compile instead of being ignored.
+template <class OP, class BIND_DATA, class = void>
+struct OperatorStatistics {
+	static void Report(TableFunctionBindInfo &, const BIND_DATA &) {
+	}
+};
+
+template <class OP, class BIND_DATA>
+struct OperatorStatistics<OP, BIND_DATA, decltype(void(&OP::Statistics))> {
+	static void Report(TableFunctionBindInfo &info, const BIND_DATA &bind_data) {
+		TableStatistics statistics;
+		OP::Statistics(bind_data, statistics);
+		if (statistics.has_cardinality) {
+			info.SetCardinality(statistics.cardinality, statistics.cardinality_is_exact);
+		}
+	}
+};
+
+//! Operators can declare a LOCAL_STATE type, which each thread that scans gets its own instance of.
+template <class OP, class = void>
+struct OperatorLocalState {
+	static constexpr bool value = false;
+	struct type {};
+};
+
+template <class OP>
+struct OperatorLocalState<OP, decltype(void(sizeof(typename OP::LOCAL_STATE)))> {
+	static constexpr bool value = true;
+	using type = typename OP::LOCAL_STATE;
+};
+
+//! A table function implemented by OP, which provides:
+//! * BIND_DATA and GLOBAL_STATE types
+//! * static void Bind(TableFunctionBindInfo &info, BIND_DATA &bind_data)
+//! * static void Init(TableFunctionInitInfo &info, BIND_DATA &bind_data, GLOBAL_STATE &state)
+//! * static void Scan(BIND_DATA &bind_data, GLOBAL_STATE &state, DataChunk &output)
+//! Scan sets the size of the output chunk, emitting an empty chunk signals the end of the scan.
+//! Operators can report their cardinality from Bind (TableFunctionBindInfo::SetCardinality) or with a Statistics
+//! function (see OperatorStatistics).
+//! Operators with a LOCAL_STATE type (see OperatorLocalState) instead provide:
+//! * static void LocalInit(TableFunctionInitInfo &info, BIND_DATA &bind_data, LOCAL_STATE &local_state)
+//! * static void Scan(BIND_DATA &bind_data, GLOBAL_STATE &state, LOCAL_STATE &local_state, DataChunk &output)
+//! and are scanned by up to TableFunctionInitInfo::SetMaxThreads threads at once, so the global state must be
+//! thread-safe. A thread that emits an empty chunk is done, the scan ends once every thread is done.
+//! Exceptions thrown by any of these are reported as errors of the query.
+template <class OP>
+class StandardTableFunction : public TableFunction {
+public:
+	using BIND_DATA = typename OP::BIND_DATA;
+	using GLOBAL_STATE = typename OP::GLOBAL_STATE;
+	using LOCAL_STATE = typename OperatorLocalState<OP>::type;
+
+	static void Bind(duckdb_bind_info info) {
+		std::unique_ptr<BIND_DATA> bind_data(new BIND_DATA());
+		try {
+			TableFunctionBindInfo bind_info(info);
+			OP::Bind(bind_info, *bind_data);
+			OperatorStatistics<OP, BIND_DATA>::Report(bind_info, *bind_data);
+		} catch (std::exception &ex) {
+			duckdb_bind_set_error(info, ex.what());
+			return;
+		}
+		duckdb_bind_set_bind_data(info, bind_data.release(), Destroy<BIND_DATA>);
+	}
+
+	static void Init(duckdb_init_info info) {
+		auto &bind_data = *reinterpret_cast<BIND_DATA *>(duckdb_init_get_bind_data(info));
+		std::unique_ptr<GLOBAL_STATE> state(new GLOBAL_STATE());
+		try {
+			TableFunctionInitInfo init_info(info);
+			OP::Init(init_info, bind_data, *state);
+		} catch (std::exception &ex) {
+			duckdb_init_set_error(info, ex.what());
+			return;
+		}
+		duckdb_init_set_init_data(info, state.release(), Destroy<GLOBAL_STATE>);
+	}
+
+	static void LocalInit(duckdb_init_info info) {
+		auto &bind_data = *reinterpret_cast<BIND_DATA *>(duckdb_init_get_bind_data(info));
+		std::unique_ptr<LOCAL_STATE> local_state(new LOCAL_STATE());
+		try {
+			TableFunctionInitInfo init_info(info);
+			CallLocalInit(init_info, bind_data, *local_state, std::integral_constant<bool, HAS_LOCAL_STATE>());
+		} catch (std::exception &ex) {
+			duckdb_init_set_error(info, ex.what());
+			return;
+		}
+		duckdb_init_set_init_data(info, local_state.release(), Destroy<LOCAL_STATE>);
+	}
+
+	static void Scan(duckdb_function_info info, duckdb_data_chunk output) {
+		auto &bind_data = *reinterpret_cast<BIND_DATA *>(duckdb_function_get_bind_data(info));
+		auto &state = *reinterpret_cast<GLOBAL_STATE *>(duckdb_function_get_init_data(info));
+		DataChunk output_chunk(output);
+		try {
+			CallScan(info, bind_data, state, output_chunk, std::integral_constant<bool, HAS_LOCAL_STATE>());
+		} catch (std::exception &ex) {
+			duckdb_function_set_error(info, ex.what());
+		}
+	}
+
+	duckdb_table_function_bind_t GetBind() const override {
+		return Bind;
+	}
+	duckdb_table_function_init_t GetInit() const override {
+		return Init;
+	}
+	duckdb_table_function_init_t GetLocalInit() const override {
+		return HAS_LOCAL_STATE ? LocalInit : nullptr;
+	}
+	duckdb_table_function_t GetFunction() const override {
+		return Scan;
+	}
+	bool ProjectionPushdown() const override {
+		return OperatorProjectionPushdown<OP>::value;
+	}
+
+private:
+	static constexpr bool HAS_LOCAL_STATE = OperatorLocalState<OP>::value;
+
+	static void CallLocalInit(TableFunctionInitInfo &info, BIND_DATA &bind_data, LOCAL_STATE &local_state,
+	                          std::true_type) {
+		OP::LocalInit(info, bind_data, local_state);
+	}
+	static void CallLocalInit(TableFunctionInitInfo &, BIND_DATA &, LOCAL_STATE &, std::false_type) {
+	}
+
+	static void CallScan(duckdb_function_info info, BIND_DATA &bind_data, GLOBAL_STATE &state, DataChunk &output,
+	                     std::true_type) {
+		auto &local_state = *reinterpret_cast<LOCAL_STATE *>(duckdb_function_get_local_init_data(info));
+		OP::Scan(bind_data, state, local_state, output);
+	}
+	static void CallScan(duckdb_function_info, BIND_DATA &bind_data, GLOBAL_STATE &state, DataChunk &output,
+	                     std::false_type) {
+		OP::Scan(bind_data, state, output);
+	}
+
+	template <class T>
+	static void Destroy(void *data) {
+		delete reinterpret_cast<T *>(data);
+	}
+};
+
+} // namespace duckdb_stable
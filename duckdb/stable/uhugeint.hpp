@@ -22,6 +22,7 @@ public:
 	}
 	uhugeint_t(const uhugeint_t &other) : value(other.value) {
 	}
+	uhugeint_t &operator=(const uhugeint_t &other) = default;
 	uhugeint_t(uint64_t upper, uint64_t lower) {
 		value.lower = lower;
 		value.upper = upper;
@@ -115,10 +116,10 @@ public:
 		return upper_bigger || (upper_equal && lower_bigger_equal);
 	}
 	bool operator<(const uhugeint_t &rhs) const {
-		return !(rhs >= *this);
+		return !(*this >= rhs);
 	}
 	bool operator<=(const uhugeint_t &rhs) const {
-		return !(rhs > *this);
+		return !(*this > rhs);
 	}
 	uhugeint_t operator+(const uhugeint_t &rhs) const {
 		return uhugeint_t(value.upper + rhs.value.upper + ((value.lower + rhs.value.lower) < value.lower),
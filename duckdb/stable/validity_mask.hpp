@@ -0,0 +1,169 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/stable/validity_mask.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/stable/common.hpp"
+#include "duckdb/stable/vector.hpp"
+
+#include <algorithm>
+
+namespace duckdb_stable {
+
+//! A non-owning view over the validity of a vector: one bit per row, 64 rows per word. A NULL mask means that every
+//! row is valid. Bits are accessed inline, without calling into the C API.
+class ValidityMask {
+public:
+	static constexpr idx_t BITS_PER_WORD = 64;
+	static constexpr uint64_t ALL_VALID = ~uint64_t(0);
+
+	ValidityMask() : validity(nullptr) {
+	}
+	explicit ValidityMask(uint64_t *validity_p) : validity(validity_p) {
+	}
+
+public:
+	static idx_t WordCount(idx_t count) {
+		return (count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	}
+
+	static bool RowIsValid(uint64_t word, idx_t bit) {
+		return (word >> bit) & 1;
+	}
+
+	static idx_t PopCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<idx_t>(__builtin_popcountll(word));
+#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<idx_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	//! Marks a row of the result invalid, making the validity of the result writable on first use.
+	static void SetInvalid(Vector &result, uint64_t *&validity, idx_t r) {
+		if (!validity) {
+			duckdb_vector_ensure_validity_writable(result.c_vector());
+			validity = duckdb_vector_get_validity(result.c_vector());
+		}
+		validity[r / BITS_PER_WORD] &= ~(uint64_t(1) << (r % BITS_PER_WORD));
+	}
+
+public:
+	bool AllValid() const {
+		return !validity;
+	}
+
+	//! The validity of rows [w * 64, w * 64 + 64) - all valid without a mask.
+	uint64_t GetWord(idx_t w) const {
+		return validity ? validity[w] : ~uint64_t(0);
+	}
+
+	bool RowIsValid(idx_t r) const {
+		return !validity || RowIsValid(validity[r / BITS_PER_WORD], r % BITS_PER_WORD);
+	}
+
+	//! Make the mask writable, all rows start out valid.
+	void EnsureWritable(Vector &vector) {
+		if (!validity) {
+			duckdb_vector_ensure_validity_writable(vector.c_vector());
+			validity = duckdb_vector_get_validity(vector.c_vector());
+		}
+	}
+
+	//! Requires a writable mask.
+	void SetInvalid(idx_t r) {
+		validity[r / BITS_PER_WORD] &= ~(uint64_t(1) << (r % BITS_PER_WORD));
+	}
+
+	//! Requires a writable mask.
+	void SetValid(idx_t r) {
+		validity[r / BITS_PER_WORD] |= uint64_t(1) << (r % BITS_PER_WORD);
+	}
+
+	//! Rows are valid if they are valid in both masks. Requires a writable mask unless other is all valid.
+	void And(const ValidityMask &other, idx_t count) {
+		if (other.AllValid()) {
+			return;
+		}
+		for (idx_t w = 0; w < WordCount(count); w++) {
+			validity[w] &= other.validity[w];
+		}
+	}
+
+	//! Rows are valid if they are valid in either mask. Requires a writable mask unless this is all valid.
+	void Or(const ValidityMask &other, idx_t count) {
+		if (AllValid()) {
+			return;
+		}
+		for (idx_t w = 0; w < WordCount(count); w++) {
+			validity[w] |= other.GetWord(w);
+		}
+	}
+
+	idx_t CountValid(idx_t count) const {
+		if (!validity) {
+			return count;
+		}
+		idx_t result = 0;
+		auto full_words = count / BITS_PER_WORD;
+		for (idx_t w = 0; w < full_words; w++) {
+			result += PopCount(validity[w]);
+		}
+		auto remaining = count % BITS_PER_WORD;
+		if (remaining > 0) {
+			result += PopCount(validity[full_words] & ((uint64_t(1) << remaining) - 1));
+		}
+		return result;
+	}
+
+	//! Calls fun(start, end) for every maximal run [start, end) of valid rows.
+	template <class FUNC>
+	void ForEachValidRun(idx_t count, FUNC fun) const {
+		if (!validity) {
+			if (count > 0) {
+				fun(idx_t(0), count);
+			}
+			return;
+		}
+		idx_t run_start = 0;
+		bool in_run = false;
+		for (idx_t base = 0; base < count; base += BITS_PER_WORD) {
+			auto word = validity[base / BITS_PER_WORD];
+			auto end = std::min<idx_t>(base + BITS_PER_WORD, count);
+			if ((word == ALL_VALID && in_run) || (word == 0 && !in_run)) {
+				continue;
+			}
+			for (idx_t r = base; r < end; r++) {
+				auto valid = RowIsValid(word, r - base);
+				if (valid && !in_run) {
+					run_start = r;
+					in_run = true;
+				} else if (!valid && in_run) {
+					fun(run_start, r);
+					in_run = false;
+				}
+			}
+		}
+		if (in_run) {
+			fun(run_start, count);
+		}
+	}
+
+public:
+	uint64_t *GetData() const {
+		return validity;
+	}
+
+private:
+	uint64_t *validity;
+};
+
+} // namespace duckdb_stable
@@ -0,0 +1,1269 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// mock/duckdb.h
+//
+//
+//===----------------------------------------------------------------------===//
+
+// A header-only implementation of the subset of the DuckDB C API that is used by the stable C++ headers. Vectors and
+// chunks are backed by plain arrays, so executor kernels can be driven from a benchmark or profiler without a DuckDB
+// process. Everything that requires a database (queries, appenders, registration) is either recorded on the mock
+// connection or fails with an error.
+
+#pragma once
+
+//! Defined so that harnesses can use the mock objects (e.g. construct a _duckdb_function_info) directly.
+#define DUCKDB_STABLE_MOCK_C_API 1
+
+#ifndef __cplusplus
+#error "The mock C API is implemented in C++ and can only be used from C++"
+#endif
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef uint64_t idx_t;
+
+typedef enum { DuckDBSuccess = 0, DuckDBError = 1 } duckdb_state;
+
+typedef enum DUCKDB_TYPE {
+	DUCKDB_TYPE_INVALID = 0,
+	DUCKDB_TYPE_BOOLEAN = 1,
+	DUCKDB_TYPE_TINYINT = 2,
+	DUCKDB_TYPE_SMALLINT = 3,
+	DUCKDB_TYPE_INTEGER = 4,
+	DUCKDB_TYPE_BIGINT = 5,
+	DUCKDB_TYPE_UTINYINT = 6,
+	DUCKDB_TYPE_USMALLINT = 7,
+	DUCKDB_TYPE_UINTEGER = 8,
+	DUCKDB_TYPE_UBIGINT = 9,
+	DUCKDB_TYPE_FLOAT = 10,
+	DUCKDB_TYPE_DOUBLE = 11,
+	DUCKDB_TYPE_TIMESTAMP = 12,
+	DUCKDB_TYPE_DATE = 13,
+	DUCKDB_TYPE_TIME = 14,
+	DUCKDB_TYPE_INTERVAL = 15,
+	DUCKDB_TYPE_HUGEINT = 16,
+	DUCKDB_TYPE_UHUGEINT = 32,
+	DUCKDB_TYPE_VARCHAR = 17,
+	DUCKDB_TYPE_BLOB = 18,
+	DUCKDB_TYPE_DECIMAL = 19,
+	DUCKDB_TYPE_TIMESTAMP_S = 20,
+	DUCKDB_TYPE_TIMESTAMP_MS = 21,
+	DUCKDB_TYPE_TIMESTAMP_NS = 22,
+	DUCKDB_TYPE_ENUM = 23,
+	DUCKDB_TYPE_LIST = 24,
+	DUCKDB_TYPE_STRUCT = 25,
+	DUCKDB_TYPE_MAP = 26,
+	DUCKDB_TYPE_ARRAY = 33,
+	DUCKDB_TYPE_UUID = 27,
+	DUCKDB_TYPE_UNION = 28,
+	DUCKDB_TYPE_BIT = 29,
+	DUCKDB_TYPE_TIME_TZ = 30,
+	DUCKDB_TYPE_TIMESTAMP_TZ = 31,
+	DUCKDB_TYPE_ANY = 34,
+	DUCKDB_TYPE_VARINT = 35,
+	DUCKDB_TYPE_SQLNULL = 36,
+} duckdb_type;
+
+typedef enum duckdb_cast_mode { DUCKDB_CAST_NORMAL = 0, DUCKDB_CAST_TRY = 1 } duckdb_cast_mode;
+
+typedef struct {
+	uint64_t lower;
+	int64_t upper;
+} duckdb_hugeint;
+
+typedef struct {
+	uint64_t lower;
+	uint64_t upper;
+} duckdb_uhugeint;
+
+typedef struct {
+	union {
+		struct {
+			uint32_t length;
+			char prefix[4];
+			char *ptr;
+		} pointer;
+		struct {
+			uint32_t length;
+			char inlined[12];
+		} inlined;
+	} value;
+} duckdb_string_t;
+
+typedef struct {
+	uint64_t offset;
+	uint64_t length;
+} duckdb_list_entry;
+
+typedef struct _duckdb_database *duckdb_database;
+typedef struct _duckdb_connection *duckdb_connection;
+typedef struct _duckdb_prepared_statement *duckdb_prepared_statement;
+typedef struct _duckdb_pending_result *duckdb_pending_result;
+typedef struct _duckdb_appender *duckdb_appender;
+typedef struct _duckdb_data_chunk *duckdb_data_chunk;
+typedef struct _duckdb_vector *duckdb_vector;
+typedef struct _duckdb_logical_type *duckdb_logical_type;
+typedef struct _duckdb_value *duckdb_value;
+typedef struct _duckdb_function_info *duckdb_function_info;
+typedef struct _duckdb_bind_info *duckdb_bind_info;
+typedef struct _duckdb_init_info *duckdb_init_info;
+typedef struct _duckdb_scalar_function *duckdb_scalar_function;
+typedef struct _duckdb_scalar_function_set *duckdb_scalar_function_set;
+typedef struct _duckdb_table_function *duckdb_table_function;
+typedef struct _duckdb_cast_function *duckdb_cast_function;
+typedef struct _duckdb_replacement_scan_info *duckdb_replacement_scan_info;
+typedef struct _duckdb_extension_info *duckdb_extension_info;
+
+typedef struct {
+	idx_t deprecated_column_count;
+	idx_t deprecated_row_count;
+	idx_t deprecated_rows_changed;
+	void *deprecated_columns;
+	char *deprecated_error_message;
+	void *internal_data;
+} duckdb_result;
+
+typedef void (*duckdb_delete_callback_t)(void *data);
+typedef void (*duckdb_scalar_function_t)(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output);
+typedef bool (*duckdb_cast_function_t)(duckdb_function_info info, idx_t count, duckdb_vector input,
+                                       duckdb_vector output);
+typedef void (*duckdb_table_function_bind_t)(duckdb_bind_info info);
+typedef void (*duckdb_table_function_init_t)(duckdb_init_info info);
+typedef void (*duckdb_table_function_t)(duckdb_function_info info, duckdb_data_chunk output);
+typedef void (*duckdb_replacement_callback_t)(duckdb_replacement_scan_info info, const char *table_name, void *data);
+
+//===--------------------------------------------------------------------===//
+// Mock objects
+//===--------------------------------------------------------------------===//
+
+struct _duckdb_logical_type {
+	duckdb_type id = DUCKDB_TYPE_INVALID;
+	std::string alias;
+	//! Struct/union members, the list/array child or the map key and value.
+	std::vector<_duckdb_logical_type> children;
+	//! Struct/union member names or the enum dictionary.
+	std::vector<std::string> names;
+	uint8_t width = 0;
+	uint8_t scale = 0;
+	idx_t array_size = 0;
+};
+
+struct _duckdb_vector {
+	_duckdb_logical_type type;
+	idx_t capacity = 0;
+	std::vector<uint64_t> data;
+	//! Empty while all rows are valid.
+	std::vector<uint64_t> validity;
+	std::vector<std::unique_ptr<_duckdb_vector>> children;
+	std::vector<std::unique_ptr<char[]>> string_heap;
+	idx_t list_size = 0;
+};
+
+struct _duckdb_data_chunk {
+	std::vector<std::unique_ptr<_duckdb_vector>> columns;
+	idx_t size = 0;
+};
+
+struct _duckdb_value {
+	duckdb_type type = DUCKDB_TYPE_SQLNULL;
+	int64_t int_value = 0;
+	double double_value = 0;
+	std::string str_value;
+};
+
+struct _duckdb_function_info {
+	void *extra_info = nullptr;
+	void *bind_data = nullptr;
+	void *init_data = nullptr;
+	void *local_init_data = nullptr;
+	duckdb_cast_mode cast_mode = DUCKDB_CAST_NORMAL;
+	bool has_error = false;
+	std::string error;
+};
+
+struct _duckdb_bind_info {
+	void *extra_info = nullptr;
+	std::vector<_duckdb_value> parameters;
+	std::vector<std::string> column_names;
+	std::vector<_duckdb_logical_type> column_types;
+	void *bind_data = nullptr;
+	duckdb_delete_callback_t bind_data_destroy = nullptr;
+	idx_t cardinality = 0;
+	bool cardinality_is_exact = false;
+	bool has_error = false;
+	std::string error;
+};
+
+struct _duckdb_init_info {
+	void *extra_info = nullptr;
+	void *bind_data = nullptr;
+	void *init_data = nullptr;
+	duckdb_delete_callback_t init_data_destroy = nullptr;
+	std::vector<idx_t> column_ids;
+	idx_t max_threads = 1;
+	bool has_error = false;
+	std::string error;
+};
+
+struct _duckdb_scalar_function {
+	std::string name;
+	std::vector<_duckdb_logical_type> parameters;
+	_duckdb_logical_type return_type;
+	_duckdb_logical_type varargs;
+	bool is_volatile = false;
+	bool special_handling = false;
+	duckdb_scalar_function_t function = nullptr;
+	//! Shared by every copy of the function, the destroy callback runs when the last copy is gone.
+	std::shared_ptr<void> extra_info;
+};
+
+struct _duckdb_scalar_function_set {
+	std::string name;
+	std::vector<_duckdb_scalar_function> functions;
+};
+
+struct _duckdb_table_function {
+	std::string name;
+	std::vector<_duckdb_logical_type> parameters;
+	//! Shared by every copy of the function, the destroy callback runs when the last copy is gone.
+	std::shared_ptr<void> extra_info;
+	duckdb_table_function_bind_t bind = nullptr;
+	duckdb_table_function_init_t init = nullptr;
+	duckdb_table_function_init_t local_init = nullptr;
+	duckdb_table_function_t function = nullptr;
+	bool projection_pushdown = false;
+};
+
+struct _duckdb_cast_function {
+	_duckdb_logical_type source;
+	_duckdb_logical_type target;
+	int64_t implicit_cast_cost = -1;
+	duckdb_cast_function_t function = nullptr;
+};
+
+//! The connection records everything that is registered on it, so a harness can inspect (and invoke) it.
+struct _duckdb_connection {
+	std::vector<_duckdb_logical_type> types;
+	std::vector<_duckdb_scalar_function> scalar_functions;
+	std::vector<_duckdb_table_function> table_functions;
+	std::vector<_duckdb_cast_function> cast_functions;
+};
+
+struct _duckdb_replacement_scan {
+	duckdb_replacement_callback_t callback = nullptr;
+	void *extra_data = nullptr;
+	duckdb_delete_callback_t delete_callback = nullptr;
+};
+
+//! The database owns the extra data of its replacement scans, like DuckDB does.
+struct _duckdb_database {
+	std::vector<_duckdb_replacement_scan> replacement_scans;
+
+	~_duckdb_database() {
+		for (auto &scan : replacement_scans) {
+			if (scan.delete_callback) {
+				scan.delete_callback(scan.extra_data);
+			}
+		}
+	}
+};
+
+struct _duckdb_replacement_scan_info {
+	std::string function_name;
+	std::vector<_duckdb_value> parameters;
+	bool has_error = false;
+	std::string error;
+};
+
+struct _duckdb_prepared_statement {};
+struct _duckdb_pending_result {};
+struct _duckdb_appender {};
+struct _duckdb_extension_info {};
+
+namespace duckdb_mock {
+
+static constexpr idx_t STANDARD_VECTOR_SIZE = 2048;
+static constexpr const char *UNSUPPORTED_ERROR = "Not supported by the mock C API";
+
+inline duckdb_type PhysicalEnumType(const _duckdb_logical_type &type) {
+	if (type.names.size() <= 0xFF) {
+		return DUCKDB_TYPE_UTINYINT;
+	}
+	if (type.names.size() <= 0xFFFF) {
+		return DUCKDB_TYPE_USMALLINT;
+	}
+	return DUCKDB_TYPE_UINTEGER;
+}
+
+inline duckdb_type PhysicalDecimalType(const _duckdb_logical_type &type) {
+	if (type.width <= 4) {
+		return DUCKDB_TYPE_SMALLINT;
+	}
+	if (type.width <= 9) {
+		return DUCKDB_TYPE_INTEGER;
+	}
+	if (type.width <= 18) {
+		return DUCKDB_TYPE_BIGINT;
+	}
+	return DUCKDB_TYPE_HUGEINT;
+}
+
+inline idx_t TypeSize(duckdb_type id) {
+	switch (id) {
+	case DUCKDB_TYPE_BOOLEAN:
+	case DUCKDB_TYPE_TINYINT:
+	case DUCKDB_TYPE_UTINYINT:
+		return 1;
+	case DUCKDB_TYPE_SMALLINT:
+	case DUCKDB_TYPE_USMALLINT:
+		return 2;
+	case DUCKDB_TYPE_INTEGER:
+	case DUCKDB_TYPE_UINTEGER:
+	case DUCKDB_TYPE_FLOAT:
+	case DUCKDB_TYPE_DATE:
+		return 4;
+	case DUCKDB_TYPE_BIGINT:
+	case DUCKDB_TYPE_UBIGINT:
+	case DUCKDB_TYPE_DOUBLE:
+	case DUCKDB_TYPE_TIMESTAMP:
+	case DUCKDB_TYPE_TIMESTAMP_S:
+	case DUCKDB_TYPE_TIMESTAMP_MS:
+	case DUCKDB_TYPE_TIMESTAMP_NS:
+	case DUCKDB_TYPE_TIMESTAMP_TZ:
+	case DUCKDB_TYPE_TIME:
+	case DUCKDB_TYPE_TIME_TZ:
+		return 8;
+	case DUCKDB_TYPE_INTERVAL:
+	case DUCKDB_TYPE_HUGEINT:
+	case DUCKDB_TYPE_UHUGEINT:
+	case DUCKDB_TYPE_UUID:
+	case DUCKDB_TYPE_LIST:
+	case DUCKDB_TYPE_MAP:
+		return 16;
+	case DUCKDB_TYPE_VARCHAR:
+	case DUCKDB_TYPE_BLOB:
+	case DUCKDB_TYPE_BIT:
+	case DUCKDB_TYPE_VARINT:
+		return sizeof(duckdb_string_t);
+	default:
+		// Struct, union and array vectors only have children.
+		return 0;
+	}
+}
+
+inline idx_t TypeSize(const _duckdb_logical_type &type) {
+	switch (type.id) {
+	case DUCKDB_TYPE_ENUM:
+		return TypeSize(PhysicalEnumType(type));
+	case DUCKDB_TYPE_DECIMAL:
+		return TypeSize(PhysicalDecimalType(type));
+	default:
+		return TypeSize(type.id);
+	}
+}
+
+inline std::unique_ptr<_duckdb_vector> CreateVector(const _duckdb_logical_type &type, idx_t capacity) {
+	std::unique_ptr<_duckdb_vector> result(new _duckdb_vector());
+	result->type = type;
+	result->capacity = capacity;
+	result->data.resize((TypeSize(type) * capacity + 7) / 8);
+	switch (type.id) {
+	case DUCKDB_TYPE_STRUCT:
+	case DUCKDB_TYPE_UNION:
+		for (auto &child : type.children) {
+			result->children.push_back(CreateVector(child, capacity));
+		}
+		break;
+	case DUCKDB_TYPE_LIST:
+		result->children.push_back(CreateVector(type.children[0], capacity));
+		break;
+	case DUCKDB_TYPE_ARRAY:
+		result->children.push_back(CreateVector(type.children[0], capacity * type.array_size));
+		break;
+	case DUCKDB_TYPE_MAP: {
+		_duckdb_logical_type entry;
+		entry.id = DUCKDB_TYPE_STRUCT;
+		entry.children = type.children;
+		entry.names = {"key", "value"};
+		result->children.push_back(CreateVector(entry, capacity));
+		break;
+	}
+	default:
+		break;
+	}
+	return result;
+}
+
+inline void ResetVector(_duckdb_vector &vector) {
+	vector.validity.clear();
+	vector.string_heap.clear();
+	vector.list_size = 0;
+	for (auto &child : vector.children) {
+		ResetVector(*child);
+	}
+}
+
+inline char *CopyString(const std::string &str) {
+	auto result = static_cast<char *>(malloc(str.size() + 1));
+	memcpy(result, str.c_str(), str.size() + 1);
+	return result;
+}
+
+inline void NoDestroy(void *) {
+}
+
+inline _duckdb_logical_type *CopyType(const _duckdb_logical_type &type) {
+	return new _duckdb_logical_type(type);
+}
+
+} // namespace duckdb_mock
+
+//===--------------------------------------------------------------------===//
+// Memory
+//===--------------------------------------------------------------------===//
+
+inline void *duckdb_malloc(size_t size) {
+	return malloc(size);
+}
+
+inline void duckdb_free(void *ptr) {
+	free(ptr);
+}
+
+inline idx_t duckdb_vector_size() {
+	return duckdb_mock::STANDARD_VECTOR_SIZE;
+}
+
+//===--------------------------------------------------------------------===//
+// Logical types
+//===--------------------------------------------------------------------===//
+
+inline duckdb_logical_type duckdb_create_logical_type(duckdb_type type) {
+	auto result = new _duckdb_logical_type();
+	result->id = type;
+	return result;
+}
+
+inline char *duckdb_logical_type_get_alias(duckdb_logical_type type) {
+	return type->alias.empty() ? nullptr : duckdb_mock::CopyString(type->alias);
+}
+
+inline void duckdb_logical_type_set_alias(duckdb_logical_type type, const char *alias) {
+	type->alias = alias;
+}
+
+inline duckdb_logical_type duckdb_create_list_type(duckdb_logical_type type) {
+	auto result = new _duckdb_logical_type();
+	result->id = DUCKDB_TYPE_LIST;
+	result->children.push_back(*type);
+	return result;
+}
+
+inline duckdb_logical_type duckdb_create_array_type(duckdb_logical_type type, idx_t array_size) {
+	auto result = new _duckdb_logical_type();
+	result->id = DUCKDB_TYPE_ARRAY;
+	result->children.push_back(*type);
+	result->array_size = array_size;
+	return result;
+}
+
+inline duckdb_logical_type duckdb_create_map_type(duckdb_logical_type key_type, duckdb_logical_type value_type) {
+	auto result = new _duckdb_logical_type();
+	result->id = DUCKDB_TYPE_MAP;
+	result->children.push_back(*key_type);
+	result->children.push_back(*value_type);
+	return result;
+}
+
+inline duckdb_logical_type duckdb_create_struct_type(duckdb_logical_type *member_types, const char **member_names,
+                                                     idx_t member_count) {
+	auto result = new _duckdb_logical_type();
+	result->id = DUCKDB_TYPE_STRUCT;
+	for (idx_t i = 0; i < member_count; i++) {
+		result->children.push_back(*member_types[i]);
+		result->names.push_back(member_names[i]);
+	}
+	return result;
+}
+
+inline duckdb_logical_type duckdb_create_union_type(duckdb_logical_type *member_types, const char **member_names,
+                                                    idx_t member_count) {
+	auto result = duckdb_create_struct_type(member_types, member_names, member_count);
+	result->id = DUCKDB_TYPE_UNION;
+	return result;
+}
+
+inline duckdb_logical_type duckdb_create_enum_type(const char **member_names, idx_t member_count) {
+	auto result = new _duckdb_logical_type();
+	result->id = DUCKDB_TYPE_ENUM;
+	for (idx_t i = 0; i < member_count; i++) {
+		result->names.push_back(member_names[i]);
+	}
+	return result;
+}
+
+inline duckdb_logical_type duckdb_create_decimal_type(uint8_t width, uint8_t scale) {
+	auto result = new _duckdb_logical_type();
+	result->id = DUCKDB_TYPE_DECIMAL;
+	result->width = width;
+	result->scale = scale;
+	return result;
+}
+
+inline duckdb_type duckdb_get_type_id(duckdb_logical_type type) {
+	return type ? type->id : DUCKDB_TYPE_INVALID;
+}
+
+inline uint8_t duckdb_decimal_width(duckdb_logical_type type) {
+	return type->width;
+}
+
+inline uint8_t duckdb_decimal_scale(duckdb_logical_type type) {
+	return type->scale;
+}
+
+inline duckdb_type duckdb_decimal_internal_type(duckdb_logical_type type) {
+	return duckdb_mock::PhysicalDecimalType(*type);
+}
+
+inline duckdb_type duckdb_enum_internal_type(duckdb_logical_type type) {
+	return duckdb_mock::PhysicalEnumType(*type);
+}
+
+inline uint32_t duckdb_enum_dictionary_size(duckdb_logical_type type) {
+	return static_cast<uint32_t>(type->names.size());
+}
+
+inline char *duckdb_enum_dictionary_value(duckdb_logical_type type, idx_t index) {
+	return duckdb_mock::CopyString(type->names[index]);
+}
+
+inline duckdb_logical_type duckdb_list_type_child_type(duckdb_logical_type type) {
+	return duckdb_mock::CopyType(type->children[0]);
+}
+
+inline duckdb_logical_type duckdb_array_type_child_type(duckdb_logical_type type) {
+	return duckdb_mock::CopyType(type->children[0]);
+}
+
+inline idx_t duckdb_array_type_array_size(duckdb_logical_type type) {
+	return type->array_size;
+}
+
+inline duckdb_logical_type duckdb_map_type_key_type(duckdb_logical_type type) {
+	return duckdb_mock::CopyType(type->children[0]);
+}
+
+inline duckdb_logical_type duckdb_map_type_value_type(duckdb_logical_type type) {
+	return duckdb_mock::CopyType(type->children[1]);
+}
+
+inline idx_t duckdb_struct_type_child_count(duckdb_logical_type type) {
+	return type->children.size();
+}
+
+inline char *duckdb_struct_type_child_name(duckdb_logical_type type, idx_t index) {
+	return duckdb_mock::CopyString(type->names[index]);
+}
+
+inline duckdb_logical_type duckdb_struct_type_child_type(duckdb_logical_type type, idx_t index) {
+	return duckdb_mock::CopyType(type->children[index]);
+}
+
+inline idx_t duckdb_union_type_member_count(duckdb_logical_type type) {
+	return type->children.size();
+}
+
+inline char *duckdb_union_type_member_name(duckdb_logical_type type, idx_t index) {
+	return duckdb_mock::CopyString(type->names[index]);
+}
+
+inline duckdb_logical_type duckdb_union_type_member_type(duckdb_logical_type type, idx_t index) {
+	return duckdb_mock::CopyType(type->children[index]);
+}
+
+inline void duckdb_destroy_logical_type(duckdb_logical_type *type) {
+	if (type && *type) {
+		delete *type;
+		*type = nullptr;
+	}
+}
+
+inline duckdb_state duckdb_register_logical_type(duckdb_connection con, duckdb_logical_type type, void *) {
+	con->types.push_back(*type);
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Data chunks and vectors
+//===--------------------------------------------------------------------===//
+
+inline duckdb_data_chunk duckdb_create_data_chunk(duckdb_logical_type *types, idx_t column_count) {
+	auto result = new _duckdb_data_chunk();
+	for (idx_t i = 0; i < column_count; i++) {
+		result->columns.push_back(duckdb_mock::CreateVector(*types[i], duckdb_mock::STANDARD_VECTOR_SIZE));
+	}
+	return result;
+}
+
+inline void duckdb_destroy_data_chunk(duckdb_data_chunk *chunk) {
+	if (chunk && *chunk) {
+		delete *chunk;
+		*chunk = nullptr;
+	}
+}
+
+inline void duckdb_data_chunk_reset(duckdb_data_chunk chunk) {
+	chunk->size = 0;
+	for (auto &column : chunk->columns) {
+		duckdb_mock::ResetVector(*column);
+	}
+}
+
+inline idx_t duckdb_data_chunk_get_column_count(duckdb_data_chunk chunk) {
+	return chunk->columns.size();
+}
+
+inline duckdb_vector duckdb_data_chunk_get_vector(duckdb_data_chunk chunk, idx_t col_idx) {
+	return col_idx < chunk->columns.size() ? chunk->columns[col_idx].get() : nullptr;
+}
+
+inline idx_t duckdb_data_chunk_get_size(duckdb_data_chunk chunk) {
+	return chunk->size;
+}
+
+inline void duckdb_data_chunk_set_size(duckdb_data_chunk chunk, idx_t size) {
+	chunk->size = size;
+}
+
+inline duckdb_vector duckdb_create_vector(duckdb_logical_type type, idx_t capacity) {
+	return duckdb_mock::CreateVector(*type, capacity).release();
+}
+
+inline void duckdb_destroy_vector(duckdb_vector *vector) {
+	if (vector && *vector) {
+		delete *vector;
+		*vector = nullptr;
+	}
+}
+
+inline duckdb_logical_type duckdb_vector_get_column_type(duckdb_vector vector) {
+	return duckdb_mock::CopyType(vector->type);
+}
+
+inline void *duckdb_vector_get_data(duckdb_vector vector) {
+	return vector->data.empty() ? nullptr : vector->data.data();
+}
+
+inline uint64_t *duckdb_vector_get_validity(duckdb_vector vector) {
+	return vector->validity.empty() ? nullptr : vector->validity.data();
+}
+
+inline void duckdb_vector_ensure_validity_writable(duckdb_vector vector) {
+	if (vector->validity.empty()) {
+		vector->validity.resize((vector->capacity + 63) / 64, ~uint64_t(0));
+	}
+}
+
+inline void duckdb_vector_assign_string_element_len(duckdb_vector vector, idx_t index, const char *str,
+                                                    idx_t str_len) {
+	auto &target = reinterpret_cast<duckdb_string_t *>(vector->data.data())[index];
+	target.value.inlined.length = static_cast<uint32_t>(str_len);
+	if (str_len <= sizeof(target.value.inlined.inlined)) {
+		memset(target.value.inlined.inlined, 0, sizeof(target.value.inlined.inlined));
+		memcpy(target.value.inlined.inlined, str, str_len);
+		return;
+	}
+	std::unique_ptr<char[]> copy(new char[str_len]);
+	memcpy(copy.get(), str, str_len);
+	memcpy(target.value.pointer.prefix, str, sizeof(target.value.pointer.prefix));
+	target.value.pointer.ptr = copy.get();
+	vector->string_heap.push_back(std::move(copy));
+}
+
+inline void duckdb_vector_assign_string_element(duckdb_vector vector, idx_t index, const char *str) {
+	duckdb_vector_assign_string_element_len(vector, index, str, strlen(str));
+}
+
+inline duckdb_vector duckdb_list_vector_get_child(duckdb_vector vector) {
+	return vector->children.empty() ? nullptr : vector->children[0].get();
+}
+
+inline idx_t duckdb_list_vector_get_size(duckdb_vector vector) {
+	return vector->list_size;
+}
+
+inline duckdb_state duckdb_list_vector_set_size(duckdb_vector vector, idx_t size) {
+	vector->list_size = size;
+	return DuckDBSuccess;
+}
+
+inline duckdb_state duckdb_list_vector_reserve(duckdb_vector vector, idx_t required_capacity) {
+	auto &child = *vector->children[0];
+	if (required_capacity <= child.capacity) {
+		return DuckDBSuccess;
+	}
+	auto new_child = duckdb_mock::CreateVector(child.type, required_capacity);
+	auto type_size = duckdb_mock::TypeSize(child.type);
+	memcpy(new_child->data.data(), child.data.data(), type_size * child.capacity);
+	if (!child.validity.empty()) {
+		new_child->validity.resize((required_capacity + 63) / 64, ~uint64_t(0));
+		memcpy(new_child->validity.data(), child.validity.data(), child.validity.size() * sizeof(uint64_t));
+	}
+	new_child->string_heap = std::move(child.string_heap);
+	vector->children[0] = std::move(new_child);
+	return DuckDBSuccess;
+}
+
+inline duckdb_vector duckdb_struct_vector_get_child(duckdb_vector vector, idx_t index) {
+	return index < vector->children.size() ? vector->children[index].get() : nullptr;
+}
+
+inline duckdb_vector duckdb_array_vector_get_child(duckdb_vector vector) {
+	return vector->children.empty() ? nullptr : vector->children[0].get();
+}
+
+inline bool duckdb_validity_row_is_valid(uint64_t *validity, idx_t row) {
+	if (!validity) {
+		return true;
+	}
+	return validity[row / 64] & (uint64_t(1) << (row % 64));
+}
+
+inline void duckdb_validity_set_row_invalid(uint64_t *validity, idx_t row) {
+	validity[row / 64] &= ~(uint64_t(1) << (row % 64));
+}
+
+inline void duckdb_validity_set_row_valid(uint64_t *validity, idx_t row) {
+	validity[row / 64] |= uint64_t(1) << (row % 64);
+}
+
+inline void duckdb_validity_set_row_validity(uint64_t *validity, idx_t row, bool valid) {
+	if (valid) {
+		duckdb_validity_set_row_valid(validity, row);
+	} else {
+		duckdb_validity_set_row_invalid(validity, row);
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Values
+//===--------------------------------------------------------------------===//
+
+inline void duckdb_destroy_value(duckdb_value *value) {
+	if (value && *value) {
+		delete *value;
+		*value = nullptr;
+	}
+}
+
+inline duckdb_value duckdb_create_varchar_length(const char *text, idx_t length) {
+	auto result = new _duckdb_value();
+	result->type = DUCKDB_TYPE_VARCHAR;
+	result->str_value = std::string(text, length);
+	return result;
+}
+
+inline duckdb_value duckdb_create_varchar(const char *text) {
+	return duckdb_create_varchar_length(text, strlen(text));
+}
+
+inline duckdb_value duckdb_create_int64(int64_t val) {
+	auto result = new _duckdb_value();
+	result->type = DUCKDB_TYPE_BIGINT;
+	result->int_value = val;
+	result->double_value = static_cast<double>(val);
+	result->str_value = std::to_string(val);
+	return result;
+}
+
+inline duckdb_value duckdb_create_bool(bool input) {
+	auto result = duckdb_create_int64(input ? 1 : 0);
+	result->type = DUCKDB_TYPE_BOOLEAN;
+	result->str_value = input ? "true" : "false";
+	return result;
+}
+
+inline duckdb_value duckdb_create_double(double input) {
+	auto result = new _duckdb_value();
+	result->type = DUCKDB_TYPE_DOUBLE;
+	result->int_value = static_cast<int64_t>(input);
+	result->double_value = input;
+	result->str_value = std::to_string(input);
+	return result;
+}
+
+inline bool duckdb_is_null_value(duckdb_value value) {
+	return !value || value->type == DUCKDB_TYPE_SQLNULL;
+}
+
+inline char *duckdb_get_varchar(duckdb_value value) {
+	return duckdb_mock::CopyString(value->str_value);
+}
+
+inline int64_t duckdb_get_int64(duckdb_value value) {
+	return value->int_value;
+}
+
+inline bool duckdb_get_bool(duckdb_value value) {
+	return value->int_value != 0;
+}
+
+inline double duckdb_get_double(duckdb_value value) {
+	return value->double_value;
+}
+
+//===--------------------------------------------------------------------===//
+// Scalar functions
+//===--------------------------------------------------------------------===//
+
+inline duckdb_scalar_function duckdb_create_scalar_function() {
+	return new _duckdb_scalar_function();
+}
+
+inline void duckdb_destroy_scalar_function(duckdb_scalar_function *function) {
+	if (function && *function) {
+		delete *function;
+		*function = nullptr;
+	}
+}
+
+inline void duckdb_scalar_function_set_name(duckdb_scalar_function function, const char *name) {
+	function->name = name;
+}
+
+inline void duckdb_scalar_function_set_varargs(duckdb_scalar_function function, duckdb_logical_type type) {
+	function->varargs = *type;
+}
+
+inline void duckdb_scalar_function_set_special_handling(duckdb_scalar_function function) {
+	function->special_handling = true;
+}
+
+inline void duckdb_scalar_function_set_volatile(duckdb_scalar_function function) {
+	function->is_volatile = true;
+}
+
+inline void duckdb_scalar_function_add_parameter(duckdb_scalar_function function, duckdb_logical_type type) {
+	function->parameters.push_back(*type);
+}
+
+inline void duckdb_scalar_function_set_return_type(duckdb_scalar_function function, duckdb_logical_type type) {
+	function->return_type = *type;
+}
+
+inline void duckdb_scalar_function_set_extra_info(duckdb_scalar_function function, void *extra_info,
+                                                  duckdb_delete_callback_t destroy) {
+	function->extra_info = std::shared_ptr<void>(extra_info, destroy ? destroy : duckdb_mock::NoDestroy);
+}
+
+inline void duckdb_scalar_function_set_function(duckdb_scalar_function function, duckdb_scalar_function_t callback) {
+	function->function = callback;
+}
+
+inline duckdb_state duckdb_register_scalar_function(duckdb_connection con, duckdb_scalar_function function) {
+	con->scalar_functions.push_back(*function);
+	return DuckDBSuccess;
+}
+
+inline void *duckdb_scalar_function_get_extra_info(duckdb_function_info info) {
+	return info->extra_info;
+}
+
+inline void duckdb_scalar_function_set_error(duckdb_function_info info, const char *error) {
+	info->has_error = true;
+	info->error = error;
+}
+
+inline duckdb_scalar_function_set duckdb_create_scalar_function_set(const char *name) {
+	auto result = new _duckdb_scalar_function_set();
+	result->name = name;
+	return result;
+}
+
+inline void duckdb_destroy_scalar_function_set(duckdb_scalar_function_set *set) {
+	if (set && *set) {
+		delete *set;
+		*set = nullptr;
+	}
+}
+
+inline duckdb_state duckdb_add_scalar_function_to_set(duckdb_scalar_function_set set,
+                                                      duckdb_scalar_function function) {
+	set->functions.push_back(*function);
+	return DuckDBSuccess;
+}
+
+inline duckdb_state duckdb_register_scalar_function_set(duckdb_connection con, duckdb_scalar_function_set set) {
+	for (auto &function : set->functions) {
+		con->scalar_functions.push_back(function);
+	}
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Table functions
+//===--------------------------------------------------------------------===//
+
+inline duckdb_table_function duckdb_create_table_function() {
+	return new _duckdb_table_function();
+}
+
+inline void duckdb_destroy_table_function(duckdb_table_function *function) {
+	if (function && *function) {
+		delete *function;
+		*function = nullptr;
+	}
+}
+
+inline void duckdb_table_function_set_name(duckdb_table_function function, const char *name) {
+	function->name = name;
+}
+
+inline void duckdb_table_function_add_parameter(duckdb_table_function function, duckdb_logical_type type) {
+	function->parameters.push_back(*type);
+}
+
+inline void duckdb_table_function_set_extra_info(duckdb_table_function function, void *extra_info,
+                                                 duckdb_delete_callback_t destroy) {
+	function->extra_info = std::shared_ptr<void>(extra_info, destroy ? destroy : duckdb_mock::NoDestroy);
+}
+
+inline void duckdb_table_function_set_bind(duckdb_table_function function, duckdb_table_function_bind_t bind) {
+	function->bind = bind;
+}
+
+inline void duckdb_table_function_set_init(duckdb_table_function function, duckdb_table_function_init_t init) {
+	function->init = init;
+}
+
+inline void duckdb_table_function_set_local_init(duckdb_table_function function, duckdb_table_function_init_t init) {
+	function->local_init = init;
+}
+
+inline void duckdb_table_function_set_function(duckdb_table_function function, duckdb_table_function_t callback) {
+	function->function = callback;
+}
+
+inline void duckdb_table_function_supports_projection_pushdown(duckdb_table_function function, bool pushdown) {
+	function->projection_pushdown = pushdown;
+}
+
+inline duckdb_state duckdb_register_table_function(duckdb_connection con, duckdb_table_function function) {
+	con->table_functions.push_back(*function);
+	return DuckDBSuccess;
+}
+
+inline void *duckdb_bind_get_extra_info(duckdb_bind_info info) {
+	return info->extra_info;
+}
+
+inline void duckdb_bind_add_result_column(duckdb_bind_info info, const char *name, duckdb_logical_type type) {
+	info->column_names.push_back(name);
+	info->column_types.push_back(*type);
+}
+
+inline idx_t duckdb_bind_get_parameter_count(duckdb_bind_info info) {
+	return info->parameters.size();
+}
+
+inline duckdb_value duckdb_bind_get_parameter(duckdb_bind_info info, idx_t index) {
+	return new _duckdb_value(info->parameters[index]);
+}
+
+inline void duckdb_bind_set_bind_data(duckdb_bind_info info, void *bind_data, duckdb_delete_callback_t destroy) {
+	info->bind_data = bind_data;
+	info->bind_data_destroy = destroy;
+}
+
+inline void duckdb_bind_set_cardinality(duckdb_bind_info info, idx_t cardinality, bool is_exact) {
+	info->cardinality = cardinality;
+	info->cardinality_is_exact = is_exact;
+}
+
+inline void duckdb_bind_set_error(duckdb_bind_info info, const char *error) {
+	info->has_error = true;
+	info->error = error;
+}
+
+inline void *duckdb_init_get_extra_info(duckdb_init_info info) {
+	return info->extra_info;
+}
+
+inline void *duckdb_init_get_bind_data(duckdb_init_info info) {
+	return info->bind_data;
+}
+
+inline void duckdb_init_set_init_data(duckdb_init_info info, void *init_data, duckdb_delete_callback_t destroy) {
+	info->init_data = init_data;
+	info->init_data_destroy = destroy;
+}
+
+inline idx_t duckdb_init_get_column_count(duckdb_init_info info) {
+	return info->column_ids.size();
+}
+
+inline idx_t duckdb_init_get_column_index(duckdb_init_info info, idx_t column_index) {
+	return info->column_ids[column_index];
+}
+
+inline void duckdb_init_set_max_threads(duckdb_init_info info, idx_t max_threads) {
+	info->max_threads = max_threads;
+}
+
+inline void duckdb_init_set_error(duckdb_init_info info, const char *error) {
+	info->has_error = true;
+	info->error = error;
+}
+
+inline void *duckdb_function_get_extra_info(duckdb_function_info info) {
+	return info->extra_info;
+}
+
+inline void *duckdb_function_get_bind_data(duckdb_function_info info) {
+	return info->bind_data;
+}
+
+inline void *duckdb_function_get_init_data(duckdb_function_info info) {
+	return info->init_data;
+}
+
+inline void *duckdb_function_get_local_init_data(duckdb_function_info info) {
+	return info->local_init_data;
+}
+
+inline void duckdb_function_set_error(duckdb_function_info info, const char *error) {
+	info->has_error = true;
+	info->error = error;
+}
+
+//===--------------------------------------------------------------------===//
+// Replacement scans
+//===--------------------------------------------------------------------===//
+
+inline void duckdb_add_replacement_scan(duckdb_database db, duckdb_replacement_callback_t replacement,
+                                        void *extra_data, duckdb_delete_callback_t delete_callback) {
+	_duckdb_replacement_scan scan;
+	scan.callback = replacement;
+	scan.extra_data = extra_data;
+	scan.delete_callback = delete_callback;
+	db->replacement_scans.push_back(scan);
+}
+
+inline void duckdb_replacement_scan_set_function_name(duckdb_replacement_scan_info info, const char *function_name) {
+	info->function_name = function_name;
+}
+
+inline void duckdb_replacement_scan_add_parameter(duckdb_replacement_scan_info info, duckdb_value parameter) {
+	info->parameters.push_back(*parameter);
+}
+
+inline void duckdb_replacement_scan_set_error(duckdb_replacement_scan_info info, const char *error) {
+	info->has_error = true;
+	info->error = error;
+}
+
+//===--------------------------------------------------------------------===//
+// Cast functions
+//===--------------------------------------------------------------------===//
+
+inline duckdb_cast_function duckdb_create_cast_function() {
+	return new _duckdb_cast_function();
+}
+
+inline void duckdb_destroy_cast_function(duckdb_cast_function *function) {
+	if (function && *function) {
+		delete *function;
+		*function = nullptr;
+	}
+}
+
+inline void duckdb_cast_function_set_source_type(duckdb_cast_function function, duckdb_logical_type source_type) {
+	function->source = *source_type;
+}
+
+inline void duckdb_cast_function_set_target_type(duckdb_cast_function function, duckdb_logical_type target_type) {
+	function->target = *target_type;
+}
+
+inline void duckdb_cast_function_set_implicit_cast_cost(duckdb_cast_function function, int64_t cost) {
+	function->implicit_cast_cost = cost;
+}
+
+inline void duckdb_cast_function_set_function(duckdb_cast_function function, duckdb_cast_function_t callback) {
+	function->function = callback;
+}
+
+inline duckdb_cast_mode duckdb_cast_function_get_cast_mode(duckdb_function_info info) {
+	return info->cast_mode;
+}
+
+inline void duckdb_cast_function_set_error(duckdb_function_info info, const char *error) {
+	info->has_error = true;
+	info->error = error;
+}
+
+inline void duckdb_cast_function_set_row_error(duckdb_function_info info, const char *error, idx_t row,
+                                               duckdb_vector output) {
+	info->has_error = true;
+	info->error = error;
+	duckdb_vector_ensure_validity_writable(output);
+	duckdb_validity_set_row_invalid(duckdb_vector_get_validity(output), row);
+}
+
+inline duckdb_state duckdb_register_cast_function(duckdb_connection con, duckdb_cast_function function) {
+	con->cast_functions.push_back(*function);
+	return DuckDBSuccess;
+}
+
+//===--------------------------------------------------------------------===//
+// Queries, prepared statements and appenders - these need a database and always fail
+//===--------------------------------------------------------------------===//
+
+inline duckdb_state duckdb_query(duckdb_connection, const char *, duckdb_result *out_result) {
+	memset(out_result, 0, sizeof(duckdb_result));
+	return DuckDBError;
+}
+
+inline void duckdb_destroy_result(duckdb_result *) {
+}
+
+inline const char *duckdb_result_error(duckdb_result *) {
+	return duckdb_mock::UNSUPPORTED_ERROR;
+}
+
+inline idx_t duckdb_column_count(duckdb_result *) {
+	return 0;
+}
+
+inline const char *duckdb_column_name(duckdb_result *, idx_t) {
+	return nullptr;
+}
+
+inline duckdb_logical_type duckdb_column_logical_type(duckdb_result *, idx_t) {
+	return nullptr;
+}
+
+inline duckdb_data_chunk duckdb_fetch_chunk(duckdb_result) {
+	return nullptr;
+}
+
+inline duckdb_state duckdb_prepare(duckdb_connection, const char *, duckdb_prepared_statement *out) {
+	*out = nullptr;
+	return DuckDBError;
+}
+
+inline void duckdb_destroy_prepare(duckdb_prepared_statement *statement) {
+	*statement = nullptr;
+}
+
+inline const char *duckdb_prepare_error(duckdb_prepared_statement) {
+	return duckdb_mock::UNSUPPORTED_ERROR;
+}
+
+inline idx_t duckdb_nparams(duckdb_prepared_statement) {
+	return 0;
+}
+
+inline duckdb_logical_type duckdb_param_logical_type(duckdb_prepared_statement, idx_t) {
+	return nullptr;
+}
+
+inline duckdb_state duckdb_clear_bindings(duckdb_prepared_statement) {
+	return DuckDBError;
+}
+
+#define DUCKDB_MOCK_BIND(NAME, TYPE)                                                                                   \
+	inline duckdb_state NAME(duckdb_prepared_statement, idx_t, TYPE) {                                                 \
+		return DuckDBError;                                                                                            \
+	}
+DUCKDB_MOCK_BIND(duckdb_bind_boolean, bool)
+DUCKDB_MOCK_BIND(duckdb_bind_int8, int8_t)
+DUCKDB_MOCK_BIND(duckdb_bind_int16, int16_t)
+DUCKDB_MOCK_BIND(duckdb_bind_int32, int32_t)
+DUCKDB_MOCK_BIND(duckdb_bind_int64, int64_t)
+DUCKDB_MOCK_BIND(duckdb_bind_hugeint, duckdb_hugeint)
+DUCKDB_MOCK_BIND(duckdb_bind_uhugeint, duckdb_uhugeint)
+DUCKDB_MOCK_BIND(duckdb_bind_uint8, uint8_t)
+DUCKDB_MOCK_BIND(duckdb_bind_uint16, uint16_t)
+DUCKDB_MOCK_BIND(duckdb_bind_uint32, uint32_t)
+DUCKDB_MOCK_BIND(duckdb_bind_uint64, uint64_t)
+DUCKDB_MOCK_BIND(duckdb_bind_float, float)
+DUCKDB_MOCK_BIND(duckdb_bind_double, double)
+#undef DUCKDB_MOCK_BIND
+
+inline duckdb_state duckdb_bind_varchar_length(duckdb_prepared_statement, idx_t, const char *, idx_t) {
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_bind_blob(duckdb_prepared_statement, idx_t, const void *, idx_t) {
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_bind_null(duckdb_prepared_statement, idx_t) {
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_execute_prepared(duckdb_prepared_statement, duckdb_result *out_result) {
+	memset(out_result, 0, sizeof(duckdb_result));
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_pending_prepared_streaming(duckdb_prepared_statement, duckdb_pending_result *out) {
+	*out = nullptr;
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_execute_pending(duckdb_pending_result, duckdb_result *out_result) {
+	memset(out_result, 0, sizeof(duckdb_result));
+	return DuckDBError;
+}
+
+inline const char *duckdb_pending_error(duckdb_pending_result) {
+	return duckdb_mock::UNSUPPORTED_ERROR;
+}
+
+inline void duckdb_destroy_pending(duckdb_pending_result *pending) {
+	*pending = nullptr;
+}
+
+inline duckdb_state duckdb_appender_create(duckdb_connection, const char *, const char *, duckdb_appender *out) {
+	*out = nullptr;
+	return DuckDBError;
+}
+
+inline idx_t duckdb_appender_column_count(duckdb_appender) {
+	return 0;
+}
+
+inline duckdb_logical_type duckdb_appender_column_type(duckdb_appender, idx_t) {
+	return nullptr;
+}
+
+inline const char *duckdb_appender_error(duckdb_appender) {
+	return duckdb_mock::UNSUPPORTED_ERROR;
+}
+
+inline duckdb_state duckdb_appender_flush(duckdb_appender) {
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_appender_close(duckdb_appender) {
+	return DuckDBError;
+}
+
+inline duckdb_state duckdb_appender_destroy(duckdb_appender *appender) {
+	*appender = nullptr;
+	return DuckDBSuccess;
+}
+
+inline duckdb_state duckdb_append_data_chunk(duckdb_appender, duckdb_data_chunk) {
+	return DuckDBError;
+}
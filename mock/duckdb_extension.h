@@ -0,0 +1,23 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// mock/duckdb_extension.h
+//
+//
+//===----------------------------------------------------------------------===//
+
+// The extension entry point of the mock C API. Functions are called directly, so there is no API struct to declare.
+
+#pragma once
+
+#include "duckdb.h"
+
+struct duckdb_extension_access {
+	void (*set_error)(duckdb_extension_info info, const char *error);
+	duckdb_database *(*get_database)(duckdb_extension_info info);
+	const void *(*get_api)(duckdb_extension_info info, const char *version);
+};
+
+#define DUCKDB_EXTENSION_EXTERN
+
+#define DUCKDB_EXTENSION_ENTRYPOINT(...) extern "C" bool duckdb_mock_extension_init(__VA_ARGS__)
@@ -0,0 +1,42 @@
+import csv
+import sys
+
+# compare the output of two benchmark_executor runs, e.g.
+# python3 scripts/compare_benchmarks.py old.csv new.csv [threshold]
+# exits with 1 when any benchmark got slower than the threshold (default 10%)
+
+KEY_COLUMNS = ['benchmark', 'null_ratio', 'string_length', 'constant']
+
+def read_results(fpath: str) -> dict:
+    results = {}
+    with open(fpath, 'r', encoding="utf8") as f:
+        for row in csv.DictReader(f):
+            key = tuple(row[column] for column in KEY_COLUMNS)
+            results[key] = float(row['rows_per_second'])
+    return results
+
+def main():
+    if len(sys.argv) not in [3, 4]:
+        print("Usage: python3 scripts/compare_benchmarks.py old.csv new.csv [threshold]")
+        return 2
+    old = read_results(sys.argv[1])
+    new = read_results(sys.argv[2])
+    threshold = float(sys.argv[3]) if len(sys.argv) == 4 else 0.1
+
+    regressions = 0
+    print('%-60s %15s %15s %8s' % ('benchmark', 'old rows/s', 'new rows/s', 'change'))
+    for key in sorted(set(old.keys()) | set(new.keys())):
+        name = ','.join(key)
+        if key not in old or key not in new:
+            print('%-60s %s' % (name, 'only in ' + (sys.argv[1] if key in old else sys.argv[2])))
+            continue
+        change = new[key] / old[key] - 1
+        marker = ''
+        if change < -threshold:
+            marker = ' REGRESSION'
+            regressions += 1
+        print('%-60s %15.0f %15.0f %+7.1f%%%s' % (name, old[key], new[key], change * 100, marker))
+    return 1 if regressions > 0 else 0
+
+if __name__ == '__main__':
+    sys.exit(main())